@@ -30,6 +30,7 @@
 #include "mesh_generator.h"
 #include "physicSoA.h"
 #include "tissuSoA.h"
+#include "scene.h"
 #include "grabbing.h"
 #include "command_console.h"
 #include "export_obj_frame.h"
@@ -97,10 +98,9 @@ int main()
 	Shader simulationShader("shaders/main_vertex_shader.vs", "shaders/main_fragment_shader.fs");
 
 	// -------------------------------------------------------------------------------------------
-	// Initialisation Tissu
-	Tissu::TissuSoA LeTissu = Tissu::TissuSoA(tissuSettings);
-	//Fixation de certain points
-	LeTissu.lockCorner(lockCorner);
+	// Initialisation Scene (un ou plusieurs tissus, fixation des coins comprise)
+	Scene::Scene scene(sceneSettings);
+	Tissu::TissuSoA& LeTissu = *scene.cloths[0].tissu; // Les objets de la scene sont places par rapport au premier tissu
 
 	if (debug)
 	{
@@ -116,37 +116,37 @@ int main()
 	auto tissu_diffuse_texture = std::make_shared<GL::Texture>("textures/drap/FabricPlainNaturalSheer009COL2K.jpg", GL::TextureFormat::JPG);
 	auto tissu_specular_texture = std::make_shared<GL::Texture>("textures/generic/black.png", GL::TextureFormat::PNG);
 	auto tissu_emissive_texture = std::make_shared<GL::Texture>("textures/generic/black.png", GL::TextureFormat::PNG);
-	GL::Material tissu_material = GL::Material(tissu_diffuse_texture, tissu_specular_texture, tissu_emissive_texture, 64.0f);
-	auto tissu_mesh = std::make_shared <GL::Mesh>(LeTissu.VBOBuffer, LeTissu.EBOBuffer);
-	GL::Model tissu_model = GL::Model(tissu_mesh);
-	GL::Renderable tissuRenderable = GL::Renderable(std::move(tissu_model), std::move(tissu_material), simulationShader, glm::vec2(screenSettings.width, screenSettings.height), false);
-	tissuRenderable.model.mesh->sendEBOBuffer();
-
-	// -------------------------------------------------------------
-	// Model Matrix (Modifie l'objet) Translate/Rotate/Scale
-	// Centering plane
-	glm::mat4 tissuModelMatrix = glm::mat4(1.0f);
-	tissuRenderable.modelMatrix = tissuModelMatrix;
-	tissuRenderable.projectionMatrix = SimpleCamera::computeProjectionMatrix(screenSettings);
-	
-	// -------------------------------------------------------------
-	// Lighting
-	Light::sendToShader(lightSettings, tissuRenderable.shader);
+	// Un renderable par tissu (memes textures), dans l'ordre de scene.cloths
+	std::vector<GL::Renderable> tissuRenderables;
+	tissuRenderables.reserve(scene.cloths.size());
+	for (Scene::Cloth& cloth : scene.cloths) {
+		auto tissu_mesh = std::make_shared <GL::Mesh>(cloth.tissu->VBOBuffer, cloth.tissu->EBOBuffer);
+		GL::Model tissu_model = GL::Model(tissu_mesh);
+		GL::Material tissu_material = GL::Material(tissu_diffuse_texture, tissu_specular_texture, tissu_emissive_texture, 64.0f);
+		tissuRenderables.emplace_back(std::move(tissu_model), std::move(tissu_material), simulationShader, glm::vec2(screenSettings.width, screenSettings.height), false);
+		GL::Renderable& tissuRenderable = tissuRenderables.back();
+		tissuRenderable.model.mesh->sendEBOBuffer();
+
+		// -------------------------------------------------------------
+		// Model Matrix (Modifie l'objet) Translate/Rotate/Scale
+		// Centering plane
+		glm::mat4 tissuModelMatrix = glm::mat4(1.0f);
+		tissuRenderable.modelMatrix = tissuModelMatrix;
+		tissuRenderable.projectionMatrix = SimpleCamera::computeProjectionMatrix(screenSettings);
+
+		// -------------------------------------------------------------
+		// Lighting
+		Light::sendToShader(lightSettings, tissuRenderable.shader);
+	}
 
 	// -------------------------------------------------------------
 	// Model Loading
-	std::vector<MeshGenerator::MeshGenerator*> listeObjectCollisionable;
+	// Objets de collision (Scene::createColliders, comme drap_headless) : seuls ceux actives dans la config sont collisionnables et affiches
+	Scene::Colliders colliders = Scene::createColliders(LeTissu, activateSphere, activateBox);
+	const std::vector<MeshGenerator::MeshGenerator*>& listeObjectCollisionable = colliders.collidables;
 
 	// Sphere
-	MeshGenerator::MeshSettings sphere_settings;
-	sphere_settings.position = glm::vec3(((LeTissu.tissuSettings.resolutionX - 1) * LeTissu.tissuSettings.gapPointStartX) / 2, ((LeTissu.tissuSettings.resolutionY - 1) * LeTissu.tissuSettings.gapPointStartY) / 2, -2.5f);
-	sphere_settings.position += glm::vec3(1.7f, 0.0f, 0.0f);
-	sphere_settings.radius = 2.7f;
-	sphere_settings.resolutionX = 20;
-	sphere_settings.resolutionY = 20;
-	sphere_settings.rotationAxis = glm::vec3(1.0f, 1.0f, 1.0f);
-
-	std::unique_ptr<MeshGenerator::MeshGenerator> sphereMeshGen = MeshGenerator::MeshFactory::createMesh(MeshGenerator::PrimitiveType::SPHERE, sphere_settings);
+	std::unique_ptr<MeshGenerator::MeshGenerator>& sphereMeshGen = colliders.sphere;
 	if (debug)
 	{
 		sphereMeshGen->printVertexPosition();
@@ -170,19 +170,9 @@ int main()
 	sphereRenderable.modelMatrix = sphereModelMatrix;
 	sphereRenderable.projectionMatrix = SimpleCamera::computeProjectionMatrix(screenSettings);
 
-	listeObjectCollisionable.emplace_back(sphereMeshGen.get());
-
 
 	// Box
-	MeshGenerator::MeshSettings box_settings;
-	box_settings.size = glm::vec3(2.0f, 4.0f, 2.0f);
-	box_settings.position = glm::vec3(((LeTissu.tissuSettings.resolutionX - 1) * LeTissu.tissuSettings.gapPointStartX) / 2, ((LeTissu.tissuSettings.resolutionY - 1) * LeTissu.tissuSettings.gapPointStartY) / 2, -1.2f);
-	box_settings.position += glm::vec3(-1.7f, 0.0f, 0.0f);
-	box_settings.resolutionX = 4;
-	box_settings.resolutionY = 4;
-	box_settings.resolutionZ = 4;
-
-	std::unique_ptr<MeshGenerator::MeshGenerator> boxMeshGen = MeshGenerator::MeshFactory::createMesh(MeshGenerator::PrimitiveType::BOX, box_settings);
+	std::unique_ptr<MeshGenerator::MeshGenerator>& boxMeshGen = colliders.box;
 	if (debug)
 	{
 		boxMeshGen->printVertexPosition();
@@ -206,8 +196,6 @@ int main()
 	boxRenderable.modelMatrix = boxModelMatrix;
 	boxRenderable.projectionMatrix = SimpleCamera::computeProjectionMatrix(screenSettings);
 
-	listeObjectCollisionable.emplace_back(boxMeshGen.get());
-
 
 	//// Cylindre
 	//MeshGenerator::MeshSettings cylinder_settings;
@@ -296,8 +284,9 @@ int main()
 	
 
 	SimulationState commandVariables{
-	.tissu = LeTissu,
+	.scene = scene,
 	};
+	loadPhysicsToggles(commandVariables, physicsSettings);
 	std::thread consoleThread(commandThread, &commandVariables);
 
 	using clock = std::chrono::high_resolution_clock;
@@ -333,16 +322,16 @@ int main()
 		// ---------------------------------------------------------------------------------
 		// Calcul physique (tout est dans physic.h, ou presque :p )
 		if (!commandVariables.pauseSimulation) {
-			transfereData(commandVariables, physicsSettings);
+			transfereData(commandVariables, scene);
 			glfwSetMouseButtonCallback(window, Grabbing::mouse_button_callback);
-			Grabbing::mouse_calculation(window, LeTissu, tissuRenderable, screenSettings);
+			Grabbing::mouse_calculation(window, commandVariables.selectedTissu(), tissuRenderables[commandVariables.selectedCloth], screenSettings);
 
-			Physics::physicCalculationSubsteped(LeTissu, listeObjectCollisionable, physicsSettings);
+			scene.physicCalculationSubsteped(listeObjectCollisionable, glfwGetTime());
 
 			if (frameCount % 6 == 0) {  //Calcul des normals toutes les 6 frames, gain de perf
-				LeTissu.calculationNormals();
+				scene.calculationNormals();
 			}
-			LeTissu.generateVBOBuffer();
+			scene.generateVBOBuffers();
 		}
 		glm::vec3 cameraPos;
 		if (commandVariables.pauseCamera) {
@@ -362,7 +351,11 @@ int main()
 		// Recording to OBJ
 		std::string recordingDirectory = "recording";
 		if (commandVariables.recordingEnabled) {
-			exportFrameAsOBJ(LeTissu.positions, LeTissu.EBOBuffer, recordingDirectory, recordingFrameNumber);
+			for (Scene::Cloth& cloth : scene.cloths) {
+				std::string clothDirectory = scene.cloths.size() == 1 ? recordingDirectory : recordingDirectory + "/" + cloth.name;
+				std::filesystem::create_directories(clothDirectory);
+				exportFrameAsOBJ(cloth.tissu->positions, cloth.tissu->EBOBuffer, clothDirectory, recordingFrameNumber);
+			}
 			recordingFrameNumber++;
 		}
 		else {
@@ -372,20 +365,23 @@ int main()
 
 		// ---------------------------------------------------------------------------------
 		// Draw tissu
-		tissuRenderable.shader.use();
-		tissuRenderable.model.mesh->VBOBuffer = LeTissu.VBOBuffer;
-		tissuRenderable.model.mesh->sendVBOBuffer();
-		tissuRenderable.viewMatrix = SimpleCamera::computeViewMatrix(cameraPos, cameraSettings.target);
-		tissuRenderable.wireframeDisplay = commandVariables.tissuWireframeEnabled;
-		if (commandVariables.tissuEnabled) 
-			tissuRenderable.draw();
+		for (size_t c = 0; c < scene.cloths.size(); c++) {
+			GL::Renderable& tissuRenderable = tissuRenderables[c];
+			tissuRenderable.shader.use();
+			tissuRenderable.model.mesh->VBOBuffer = scene.cloths[c].tissu->VBOBuffer;
+			tissuRenderable.model.mesh->sendVBOBuffer();
+			tissuRenderable.viewMatrix = SimpleCamera::computeViewMatrix(cameraPos, cameraSettings.target);
+			tissuRenderable.wireframeDisplay = commandVariables.tissuWireframeEnabled;
+			if (commandVariables.tissuEnabled) 
+				tissuRenderable.draw();
+		}
 
 		// ---------------------------------------------------------------------------------
 		// Draw Sphere
 		sphereRenderable.shader.use();
 		sphereRenderable.viewMatrix = SimpleCamera::computeViewMatrix(cameraPos, cameraSettings.target);
 		sphereRenderable.wireframeDisplay = commandVariables.sphereWireframeEnabled;
-		if (commandVariables.sphereEnabled)
+		if (activateSphere && commandVariables.sphereEnabled)
 			sphereRenderable.draw();
 		
 
@@ -394,7 +390,7 @@ int main()
 		boxRenderable.shader.use();
 		boxRenderable.viewMatrix = SimpleCamera::computeViewMatrix(cameraPos, cameraSettings.target);
 		boxRenderable.wireframeDisplay = commandVariables.boxWireframeEnabled;
-		if (commandVariables.boxEnabled)
+		if (activateBox && commandVariables.boxEnabled)
 			boxRenderable.draw();
 
 		//// ---------------------------------------------------------------------------------
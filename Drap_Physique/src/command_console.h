@@ -12,6 +12,7 @@
 
 #include "tissuSoA.h"
 #include "physicSoA.h"
+#include "scene.h"
 #include "glencapsulation.h"
 
 // ----------------------------------------------------------------------------------------------------
@@ -39,8 +40,20 @@ bool clearFolder(const std::string& folderPath) {
     }
 }
 
+enum PhysicsToggle : int {
+    TOGGLE_GRAVITY = 1 << 0,
+    TOGGLE_TENSION = 1 << 1,
+    TOGGLE_COLLISION = 1 << 2,
+    TOGGLE_SELF_COLLISION = 1 << 3,
+    TOGGLE_WIND = 1 << 4,
+    TOGGLE_GRAB = 1 << 5,
+};
+
 struct SimulationState {
-    Tissu::TissuSoA& tissu;
+    Scene::Scene& scene;
+    std::atomic<int> selectedCloth = 0; // Tissu vise par fixVertex / unlockVertex et par le grab
+
+    Tissu::TissuSoA& selectedTissu() { return *scene.cloths[selectedCloth].tissu; }
 
     std::atomic<bool> pauseSimulation = false;
     std::atomic<bool> pauseCamera = false;
@@ -51,6 +64,7 @@ struct SimulationState {
     std::atomic<bool> selfCollisionEnabled = false;
     std::atomic<bool> windEnabled = true;
     std::atomic<bool> grabEnabled = true;
+    std::atomic<int> changedPhysicsToggles = 0; // Bits PhysicsToggle modifies par la console, pas encore transferes aux tissus
 
     std::atomic<bool> tissuEnabled = true;
     std::atomic<bool> sphereEnabled = true;
@@ -86,6 +100,12 @@ auto setBoolFlag = [&](std::atomic<bool>& flag, bool value, const std::string& n
     std::cout << name << " set to " << (value ? "enabled" : "disabled") << "\n";
     };
 
+// Les interrupteurs physiques marquent en plus leur bit : seul ce qui a change est ecrit dans les tissus
+void setPhysicsFlag(SimulationState* sim, std::atomic<bool>& flag, PhysicsToggle toggle, bool value, const std::string& name) {
+    setBoolFlag(flag, value, name);
+    sim->changedPhysicsToggles |= toggle;
+}
+
 void commandThread(SimulationState* sim)
 {
     std::string input;
@@ -99,32 +119,56 @@ void commandThread(SimulationState* sim)
         // -----------------
 
         if (command == "resetPos") {
-            sim->tissu.resetPosition();
+            for (Scene::Cloth& cloth : sim->scene.cloths)
+                cloth.tissu->resetPosition();
             std::cout << "   Tissu reseted" << std::endl;
         }
         else if (command == "lockCorner") {
-            sim->tissu.lockCorner(true);
+            for (Scene::Cloth& cloth : sim->scene.cloths)
+                cloth.tissu->lockCorner(true);
             std::cout << "   Corner locked" << std::endl;
         }
         else if (command == "unlockCorner") {
-            sim->tissu.lockCorner(false);
+            for (Scene::Cloth& cloth : sim->scene.cloths)
+                cloth.tissu->lockCorner(false);
             std::cout << "   Corner unlocked" << std::endl;
         }
         else if (command == "lockSide") {
-            sim->tissu.lockSide(true);
+            for (Scene::Cloth& cloth : sim->scene.cloths)
+                cloth.tissu->lockSide(true);
             std::cout << "   Corner locked" << std::endl;
         }
         else if (command == "unlockSide") {
-            sim->tissu.lockSide(false);
+            for (Scene::Cloth& cloth : sim->scene.cloths)
+                cloth.tissu->lockSide(false);
             std::cout << "   Corner unlocked" << std::endl;
         }
+        else if (command == "selectCloth") {
+            int c;
+            if (!(std::istringstream(target) >> c) || c < 0 || c >= static_cast<int>(sim->scene.cloths.size())) {
+                std::cout << "Usage: " << command << " <0.." << sim->scene.cloths.size() - 1 << ">\n";
+            }
+            else {
+                sim->selectedCloth = c;
+                std::cout << "   Cloth " << c << " (" << sim->scene.cloths[c].name << ") selected" << std::endl;
+            }
+        }
+        else if (command == "listCloths") {
+            for (size_t c = 0; c < sim->scene.cloths.size(); c++) {
+                const Tissu::TissuSoA& tissu = *sim->scene.cloths[c].tissu;
+                std::cout << "   " << c << " : " << sim->scene.cloths[c].name << " (" << tissu.tissuSettings.resolutionX << "x" << tissu.tissuSettings.resolutionY << ")"
+                    << (static_cast<int>(c) == sim->selectedCloth ? " *" : "") << "\n";
+            }
+        }
         else if (command == "fixVertex") {
             float i, j;
             if (!(iss >> i >> j)) {
                 std::cout << "Usage: " << command << " fixVertex <i> <j>\n";
             }
             else {
-                sim->tissu.isFixed[sim->tissu.getIndex(i,j)] = true;
+                Tissu::TissuSoA& tissu = sim->selectedTissu();
+                tissu.setFixed(tissu.getIndex(i, j), true);
+                tissu.sleepTiles.isWakeRequested = true;
             }
         }
         else if (command == "unlockVertex") {
@@ -133,7 +177,9 @@ void commandThread(SimulationState* sim)
                 std::cout << "Usage: " << command << " unfixVertex <i> <j>\n";
             }
             else {
-                sim->tissu.isFixed[sim->tissu.getIndex(i, j)] = false;
+                Tissu::TissuSoA& tissu = sim->selectedTissu();
+                tissu.setFixed(tissu.getIndex(i, j), false);
+                tissu.sleepTiles.isWakeRequested = true;
             }
         }
         else if (command == "pause") {
@@ -156,12 +202,12 @@ void commandThread(SimulationState* sim)
         else if (command == "enable" || command == "disable") {
             bool value = (command == "enable");
 
-            if (target == "gravity")             setBoolFlag(sim->gravityEnabled, value, "gravity");
-            else if (target == "tension")        setBoolFlag(sim->tensionEnabled, value, "tension");
-            else if (target == "collision")      setBoolFlag(sim->collisionEnabled, value, "collision");
-            else if (target == "selfCollision")  setBoolFlag(sim->selfCollisionEnabled, value, "selfCollision");
-            else if (target == "wind")           setBoolFlag(sim->windEnabled, value, "wind");
-            else if (target == "grab")           setBoolFlag(sim->grabEnabled, value, "grab");
+            if (target == "gravity")             setPhysicsFlag(sim, sim->gravityEnabled, TOGGLE_GRAVITY, value, "gravity");
+            else if (target == "tension")        setPhysicsFlag(sim, sim->tensionEnabled, TOGGLE_TENSION, value, "tension");
+            else if (target == "collision")      setPhysicsFlag(sim, sim->collisionEnabled, TOGGLE_COLLISION, value, "collision");
+            else if (target == "selfCollision")  setPhysicsFlag(sim, sim->selfCollisionEnabled, TOGGLE_SELF_COLLISION, value, "selfCollision");
+            else if (target == "wind")           setPhysicsFlag(sim, sim->windEnabled, TOGGLE_WIND, value, "wind");
+            else if (target == "grab")           setPhysicsFlag(sim, sim->grabEnabled, TOGGLE_GRAB, value, "grab");
 
             else if (target == "tissu")          setBoolFlag(sim->tissuEnabled, value, "tissu");
             else if (target == "sphere")         setBoolFlag(sim->sphereEnabled, value, "sphere");
@@ -221,6 +267,8 @@ void commandThread(SimulationState* sim)
             std::cout << "  lockSide / unlockSide       -> Locks or unlocks the borders of the cloth\n";
             std::cout << "  fixVertex <i> <j>           -> Fixes vertex at position (i, j)\n";
             std::cout << "  unlockVertex <i> <j>        -> Unlocks vertex at position (i, j)\n";
+            std::cout << "  selectCloth <c>             -> Selects the cloth used by fixVertex, unlockVertex and grab\n";
+            std::cout << "  listCloths                  -> Lists the cloths of the scene\n";
             std::cout << "  pause                       -> Toggles simulation pause\n";
             std::cout << "  pauseCamera                 -> Toggles camera movement pause\n";
             std::cout << "  startRecording              -> Starts recording the simulation\n";
@@ -249,13 +297,32 @@ void commandThread(SimulationState* sim)
 
 
 
-void transfereData(SimulationState& sim, Physics::PhysicsSettings& physicsSettings) {
-    physicsSettings.gravitySettings.isEnabled = sim.gravityEnabled;
-    physicsSettings.tensionSettings.isEnabled = sim.tensionEnabled;
-    physicsSettings.collisionSettings.isEnabled = sim.collisionEnabled;
-    physicsSettings.selfCollisionSettings.isEnabled = sim.selfCollisionEnabled;
-    physicsSettings.windSettings.isEnabled = sim.windEnabled;
-    physicsSettings.grabSettings.isEnabled = sim.grabEnabled;
+// Les interrupteurs de la console partent de la configuration chargee (reglages de base du fichier)
+void loadPhysicsToggles(SimulationState& sim, const Physics::PhysicsSettings& physicsSettings) {
+    sim.gravityEnabled = physicsSettings.gravitySettings.isEnabled;
+    sim.tensionEnabled = physicsSettings.tensionSettings.isEnabled;
+    sim.collisionEnabled = physicsSettings.collisionSettings.isEnabled;
+    sim.selfCollisionEnabled = physicsSettings.selfCollisionSettings.isEnabled;
+    sim.windEnabled = physicsSettings.windSettings.isEnabled;
+    sim.grabEnabled = physicsSettings.grabSettings.isEnabled;
+}
+
+void transfereData(SimulationState& sim, Physics::PhysicsSettings& physicsSettings, int toggles) {
+    if (toggles & TOGGLE_GRAVITY) physicsSettings.gravitySettings.isEnabled = sim.gravityEnabled;
+    if (toggles & TOGGLE_TENSION) physicsSettings.tensionSettings.isEnabled = sim.tensionEnabled;
+    if (toggles & TOGGLE_COLLISION) physicsSettings.collisionSettings.isEnabled = sim.collisionEnabled;
+    if (toggles & TOGGLE_SELF_COLLISION) physicsSettings.selfCollisionSettings.isEnabled = sim.selfCollisionEnabled;
+    if (toggles & TOGGLE_WIND) physicsSettings.windSettings.isEnabled = sim.windEnabled;
+    if (toggles & TOGGLE_GRAB) physicsSettings.grabSettings.isEnabled = sim.grabEnabled;
+}
+
+// N'ecrit que les interrupteurs changes depuis le dernier appel : les reglages propres a chaque tissu sont conserves sinon
+void transfereData(SimulationState& sim, Scene::Scene& scene) {
+    const int toggles = sim.changedPhysicsToggles.exchange(0);
+    if (toggles == 0)
+        return;
+    for (Scene::Cloth& cloth : scene.cloths)
+        transfereData(sim, cloth.physicsSettings, toggles);
 }
 
 
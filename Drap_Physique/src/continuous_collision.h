@@ -0,0 +1,311 @@
+#ifndef CONTINUOUS_COLLISION_H
+#define CONTINUOUS_COLLISION_H
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------------------------------
+// Detection continue (CCD) point-triangle et arete-arete pour l'auto-collision par triangles
+// Chaque point se deplace en ligne droite pendant le pas : x(t) = x0 + t * (x1 - x0), t dans [0, 1].
+// Les quatre points deviennent coplanaires aux racines d'un polynome de degre 3 (produit mixte) : a chaque racine
+// la distance entre les deux primitives est comparee a l'epaisseur. Si aucune racine ne donne de contact, la distance
+// a la fin du pas est testee (proximite). Un contact donne une contrainte sur les positions de fin :
+//   normal . (sum_k coefficients[k] * x1[vertices[k]]) >= thickness
+// avec une normale orientee vers le cote ou se trouvait la premiere primitive au debut du pas : un point qui a
+// traverse est ramene du bon cote, au lieu d'etre repousse plus loin.
+
+namespace ContinuousCollision
+{
+	enum ContactType : uint32_t {
+		VERTEX_TRIANGLE = 0,
+		EDGE_EDGE = 1,
+	};
+
+	struct Contact {
+		uint32_t type = VERTEX_TRIANGLE;
+		uint32_t primitiveA = 0; // Point ou arete
+		uint32_t primitiveB = 0; // Triangle ou arete
+		std::array<uint32_t, 4> vertices = {};
+		std::array<float, 4> coefficients = {};
+		glm::vec3 normal = glm::vec3(0.0f);
+
+		// Ordre de resolution : resultat independant des threads
+		bool operator<(const Contact& other) const
+		{
+			if (type != other.type) return type < other.type;
+			if (primitiveA != other.primitiveA) return primitiveA < other.primitiveA;
+			return primitiveB < other.primitiveB;
+		}
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Racines de a t^3 + b t^2 + c t + d dans [0, 1], par ordre croissant
+	// L'intervalle est coupe aux extremums du polynome : sur chaque morceau monotone, un changement de signe
+	// encadre une seule racine, trouvee par dichotomie
+	inline int cubicRootsInUnitInterval(double a, double b, double c, double d, double roots[3])
+	{
+		const double scale = std::max(std::max(std::abs(a), std::abs(b)), std::max(std::abs(c), std::abs(d)));
+		if (scale < 1e-30)
+			return 0; // Polynome nul : mouvement dans un plan, seule la proximite est testee
+
+		auto f = [&](double t) { return ((a * t + b) * t + c) * t + d; };
+
+		double bounds[4] = { 0.0, 0.0, 0.0, 1.0 };
+		int boundCount = 1;
+		// Extremums : racines de 3a t^2 + 2b t + c
+		const double qa = 3.0 * a, qb = 2.0 * b, qc = c;
+		double critical[2];
+		int criticalCount = 0;
+		if (std::abs(qa) > 1e-30 * scale) {
+			const double discriminant = qb * qb - 4.0 * qa * qc;
+			if (discriminant >= 0.0) {
+				const double root = std::sqrt(discriminant);
+				critical[criticalCount++] = (-qb - root) / (2.0 * qa);
+				critical[criticalCount++] = (-qb + root) / (2.0 * qa);
+				if (critical[0] > critical[1]) std::swap(critical[0], critical[1]);
+			}
+		}
+		else if (std::abs(qb) > 1e-30 * scale) {
+			critical[criticalCount++] = -qc / qb;
+		}
+		for (int k = 0; k < criticalCount; k++)
+			if (critical[k] > 0.0 && critical[k] < 1.0)
+				bounds[boundCount++] = critical[k];
+		bounds[boundCount++] = 1.0;
+
+		int rootCount = 0;
+		for (int k = 0; k + 1 < boundCount; k++) {
+			double lo = bounds[k], hi = bounds[k + 1];
+			double fLo = f(lo), fHi = f(hi);
+			if (fLo == 0.0) {
+				if (rootCount == 0 || lo > roots[rootCount - 1])
+					roots[rootCount++] = lo;
+				continue;
+			}
+			if (fLo * fHi > 0.0)
+				continue;
+			for (int iteration = 0; iteration < 50; iteration++) {
+				const double mid = 0.5 * (lo + hi);
+				const double fMid = f(mid);
+				if ((fMid < 0.0) == (fLo < 0.0)) { lo = mid; fLo = fMid; }
+				else hi = mid;
+			}
+			if (rootCount == 0 || hi > roots[rootCount - 1])
+				roots[rootCount++] = hi;
+			if (rootCount == 3)
+				break;
+		}
+		return rootCount;
+	}
+
+	// Coefficients du produit mixte (e1(t) x e2(t)) . e3(t), avec e(t) = e0 + t * ev
+	inline void coplanarityCubic(const glm::dvec3& e10, const glm::dvec3& e1v, const glm::dvec3& e20, const glm::dvec3& e2v,
+		const glm::dvec3& e30, const glm::dvec3& e3v, double& a, double& b, double& c, double& d)
+	{
+		const glm::dvec3 crossA = glm::cross(e10, e20);
+		const glm::dvec3 crossB = glm::cross(e10, e2v) + glm::cross(e1v, e20);
+		const glm::dvec3 crossC = glm::cross(e1v, e2v);
+		a = glm::dot(crossC, e3v);
+		b = glm::dot(crossB, e3v) + glm::dot(crossC, e30);
+		c = glm::dot(crossA, e3v) + glm::dot(crossB, e30);
+		d = glm::dot(crossA, e30);
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Point le plus proche de p sur le triangle abc (Ericson, Real-Time Collision Detection 5.1.5), en coordonnees barycentriques
+	inline glm::vec3 closestTriangleBarycentric(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+		const float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+		if (d1 <= 0.0f && d2 <= 0.0f) return glm::vec3(1.0f, 0.0f, 0.0f);
+
+		const glm::vec3 bp = p - b;
+		const float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+		if (d3 >= 0.0f && d4 <= d3) return glm::vec3(0.0f, 1.0f, 0.0f);
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+			const float v = d1 / (d1 - d3);
+			return glm::vec3(1.0f - v, v, 0.0f);
+		}
+
+		const glm::vec3 cp = p - c;
+		const float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+		if (d6 >= 0.0f && d5 <= d6) return glm::vec3(0.0f, 0.0f, 1.0f);
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+			const float w = d2 / (d2 - d6);
+			return glm::vec3(1.0f - w, 0.0f, w);
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+			const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return glm::vec3(0.0f, 1.0f - w, w);
+		}
+
+		const float denominator = 1.0f / (va + vb + vc);
+		const float v = vb * denominator;
+		const float w = vc * denominator;
+		return glm::vec3(1.0f - v - w, v, w);
+	}
+
+	// Parametres (s, u) des points les plus proches des segments p1p2 et q1q2 (Ericson 5.1.9)
+	inline glm::vec2 closestSegmentParameters(const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& q1, const glm::vec3& q2)
+	{
+		const glm::vec3 d1 = p2 - p1, d2 = q2 - q1, r = p1 - q1;
+		const float a = glm::dot(d1, d1), e = glm::dot(d2, d2), f = glm::dot(d2, r);
+		const float epsilon = 1e-12f;
+		float s, u;
+		if (a <= epsilon && e <= epsilon) return glm::vec2(0.0f);
+		if (a <= epsilon) {
+			s = 0.0f;
+			u = glm::clamp(f / e, 0.0f, 1.0f);
+		}
+		else {
+			const float c = glm::dot(d1, r);
+			if (e <= epsilon) {
+				u = 0.0f;
+				s = glm::clamp(-c / a, 0.0f, 1.0f);
+			}
+			else {
+				const float b = glm::dot(d1, d2);
+				const float denominator = a * e - b * b;
+				s = denominator > epsilon * a * e ? glm::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+				u = (b * s + f) / e;
+				if (u < 0.0f) { u = 0.0f; s = glm::clamp(-c / a, 0.0f, 1.0f); }
+				else if (u > 1.0f) { u = 1.0f; s = glm::clamp((b - c) / a, 0.0f, 1.0f); }
+			}
+		}
+		return glm::vec2(s, u);
+	}
+
+	// Signe du cote de depart : distance signee au debut du pas, ou, si le point partait dans le plan, oppose au deplacement
+	inline float startingSide(const glm::vec3& normal, float startDistance, const glm::vec3& relativeDisplacement)
+	{
+		if (std::abs(startDistance) > 1e-9f)
+			return startDistance > 0.0f ? 1.0f : -1.0f;
+		return glm::dot(normal, relativeDisplacement) > 0.0f ? -1.0f : 1.0f;
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Point p contre triangle (a, b, c) : positions de debut (0) et de fin (1) du pas
+	inline bool vertexTriangle(const glm::vec3& p0, const glm::vec3& a0, const glm::vec3& b0, const glm::vec3& c0,
+		const glm::vec3& p1, const glm::vec3& a1, const glm::vec3& b1, const glm::vec3& c1,
+		float thickness, Contact& contact)
+	{
+		const float thickness2 = thickness * thickness;
+
+		// Distance a la fin du pas : elle ne varie pas plus que le deplacement du point plus le plus grand deplacement
+		// d'un sommet du triangle. Au-dela, aucun contact possible pendant le pas (cas de presque tous les candidats)
+		const glm::vec3 endBarycentric = closestTriangleBarycentric(p1, a1, b1, c1);
+		const glm::vec3 endDelta = p1 - (endBarycentric.x * a1 + endBarycentric.y * b1 + endBarycentric.z * c1);
+		const float endDistance2 = glm::dot(endDelta, endDelta);
+		const float motion = glm::length(p1 - p0) + std::max(glm::length(a1 - a0), std::max(glm::length(b1 - b0), glm::length(c1 - c0)));
+		if (endDistance2 >= (thickness + motion) * (thickness + motion))
+			return false;
+
+		glm::vec3 barycentric(0.0f);
+		bool isHit = false;
+
+		double ca, cb, cc, cd;
+		coplanarityCubic(glm::dvec3(b0 - a0), glm::dvec3((b1 - b0) - (a1 - a0)),
+			glm::dvec3(c0 - a0), glm::dvec3((c1 - c0) - (a1 - a0)),
+			glm::dvec3(p0 - a0), glm::dvec3((p1 - p0) - (a1 - a0)), ca, cb, cc, cd);
+		double roots[3];
+		const int rootCount = cubicRootsInUnitInterval(ca, cb, cc, cd, roots);
+		for (int k = 0; k < rootCount && !isHit; k++) {
+			const float t = static_cast<float>(roots[k]);
+			const glm::vec3 p = glm::mix(p0, p1, t), a = glm::mix(a0, a1, t), b = glm::mix(b0, b1, t), c = glm::mix(c0, c1, t);
+			const glm::vec3 bary = closestTriangleBarycentric(p, a, b, c);
+			const glm::vec3 delta = p - (bary.x * a + bary.y * b + bary.z * c);
+			if (glm::dot(delta, delta) < thickness2) {
+				barycentric = bary;
+				isHit = true;
+			}
+		}
+		if (!isHit) {
+			if (endDistance2 >= thickness2)
+				return false;
+			barycentric = endBarycentric;
+		}
+
+		glm::vec3 normal = glm::cross(b1 - a1, c1 - a1);
+		const float normalLength = glm::length(normal);
+		if (normalLength < 1e-12f)
+			return false; // Triangle degenere
+		normal /= normalLength;
+
+		const glm::vec3 start0 = barycentric.x * a0 + barycentric.y * b0 + barycentric.z * c0;
+		const glm::vec3 start1 = barycentric.x * a1 + barycentric.y * b1 + barycentric.z * c1;
+		const float side = startingSide(normal, glm::dot(normal, p0 - start0), (p1 - start1) - (p0 - start0));
+
+		contact.coefficients = { 1.0f, -barycentric.x, -barycentric.y, -barycentric.z };
+		contact.normal = side * normal;
+		return true;
+	}
+
+	// Arete p (p1p2) contre arete q (q1q2) : positions de debut (0) et de fin (1) du pas
+	inline bool edgeEdge(const glm::vec3& pA0, const glm::vec3& pB0, const glm::vec3& qA0, const glm::vec3& qB0,
+		const glm::vec3& pA1, const glm::vec3& pB1, const glm::vec3& qA1, const glm::vec3& qB1,
+		float thickness, Contact& contact)
+	{
+		const float thickness2 = thickness * thickness;
+
+		// Meme filtre que vertexTriangle : distance de fin moins le plus grand deplacement possible des deux aretes
+		const glm::vec2 endParameters = closestSegmentParameters(pA1, pB1, qA1, qB1);
+		const glm::vec3 endDelta = glm::mix(pA1, pB1, endParameters.x) - glm::mix(qA1, qB1, endParameters.y);
+		const float endDistance2 = glm::dot(endDelta, endDelta);
+		const float motion = std::max(glm::length(pA1 - pA0), glm::length(pB1 - pB0)) + std::max(glm::length(qA1 - qA0), glm::length(qB1 - qB0));
+		if (endDistance2 >= (thickness + motion) * (thickness + motion))
+			return false;
+
+		glm::vec2 parameters(0.0f);
+		bool isHit = false;
+
+		double ca, cb, cc, cd;
+		coplanarityCubic(glm::dvec3(pB0 - pA0), glm::dvec3((pB1 - pB0) - (pA1 - pA0)),
+			glm::dvec3(qB0 - qA0), glm::dvec3((qB1 - qB0) - (qA1 - qA0)),
+			glm::dvec3(qA0 - pA0), glm::dvec3((qA1 - qA0) - (pA1 - pA0)), ca, cb, cc, cd);
+		double roots[3];
+		const int rootCount = cubicRootsInUnitInterval(ca, cb, cc, cd, roots);
+		for (int k = 0; k < rootCount && !isHit; k++) {
+			const float t = static_cast<float>(roots[k]);
+			const glm::vec3 pA = glm::mix(pA0, pA1, t), pB = glm::mix(pB0, pB1, t);
+			const glm::vec3 qA = glm::mix(qA0, qA1, t), qB = glm::mix(qB0, qB1, t);
+			const glm::vec2 su = closestSegmentParameters(pA, pB, qA, qB);
+			const glm::vec3 delta = glm::mix(pA, pB, su.x) - glm::mix(qA, qB, su.y);
+			if (glm::dot(delta, delta) < thickness2) {
+				parameters = su;
+				isHit = true;
+			}
+		}
+		if (!isHit) {
+			if (endDistance2 >= thickness2)
+				return false;
+			parameters = endParameters;
+		}
+
+		// Aretes paralleles : pas de normale, le contact est laisse aux tests point-triangle
+		const glm::vec3 edgeP = pB1 - pA1, edgeQ = qB1 - qA1;
+		glm::vec3 normal = glm::cross(edgeP, edgeQ);
+		const float normalLength2 = glm::dot(normal, normal);
+		if (normalLength2 < 1e-6f * glm::dot(edgeP, edgeP) * glm::dot(edgeQ, edgeQ))
+			return false;
+		normal *= 1.0f / std::sqrt(normalLength2);
+
+		const glm::vec3 startP = glm::mix(pA0, pB0, parameters.x), startQ = glm::mix(qA0, qB0, parameters.y);
+		const glm::vec3 endP = glm::mix(pA1, pB1, parameters.x), endQ = glm::mix(qA1, qB1, parameters.y);
+		const float side = startingSide(normal, glm::dot(normal, startP - startQ), (endP - endQ) - (startP - startQ));
+
+		contact.coefficients = { 1.0f - parameters.x, parameters.x, -(1.0f - parameters.y), -parameters.y };
+		contact.normal = side * normal;
+		return true;
+	}
+}
+
+#endif
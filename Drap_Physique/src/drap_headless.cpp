@@ -0,0 +1,127 @@
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <omp.h>
+#include <glm/glm.hpp>
+
+#include "simulation_config.h"
+#include "mesh_generator.h"
+#include "physicSoA.h"
+#include "tissuSoA.h"
+#include "scene.h"
+#include "export_obj_frame.h"
+
+// -------------------------------------------------------------------------------------------
+// Simulation sans fenetre ni OpenGL : charge la config, calcule N frames aussi vite que possible
+// et ecrit les frames en .obj (pour les noeuds de rendu sans ecran ni GPU)
+//
+// Usage : drap_headless [--frames N] [--config json/config.json] [--output recording] [--exportEvery K] [--threads T]
+//   --exportEvery 0 : seule la derniere frame est ecrite
+//   Scene de plusieurs tissus : chaque tissu ecrit ses frames dans <output>/<nom du tissu>
+
+// -------------------------------------------------------------------------------------------
+
+struct HeadlessSettings {
+	int frames = 600;
+	std::string configPath = "json/config.json";
+	std::string outputDirectory = "recording";
+	int exportEvery = 1;
+	int threads = 0; // 0 : valeur par defaut d'OpenMP
+	double frameDuration = 1.0 / 60.0; // Meme cadence que la boucle fenetree, sert d'horloge pour le vent
+};
+
+bool parseArguments(int argc, char** argv, HeadlessSettings& settings)
+{
+	for (int a = 1; a < argc; a++) {
+		std::string arg = argv[a];
+		if (a + 1 >= argc) {
+			std::cerr << "Missing value for argument: " << arg << std::endl;
+			return false;
+		}
+		std::string value = argv[++a];
+
+		if (arg == "--frames")           settings.frames = std::stoi(value);
+		else if (arg == "--config")      settings.configPath = value;
+		else if (arg == "--output")      settings.outputDirectory = value;
+		else if (arg == "--exportEvery") settings.exportEvery = std::stoi(value);
+		else if (arg == "--threads")     settings.threads = std::stoi(value);
+		else {
+			std::cerr << "Unknown argument: " << arg << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// -------------------------------------------------------------------------------------------
+// Main
+int main(int argc, char** argv)
+{
+	HeadlessSettings headlessSettings;
+	if (!parseArguments(argc, argv, headlessSettings)) {
+		std::cerr << "Usage: drap_headless [--frames N] [--config path] [--output dir] [--exportEvery K] [--threads T]" << std::endl;
+		return -1;
+	}
+	if (headlessSettings.threads > 0)
+		omp_set_num_threads(headlessSettings.threads);
+
+	// -------------------------------------------------------------------------------------------
+	// Load config
+	if (!Config::loadSimulationFromJSON(headlessSettings.configPath))
+		return -1;
+
+	// -------------------------------------------------------------------------------------------
+	// Initialisation Scene (un ou plusieurs tissus)
+	Scene::Scene scene(sceneSettings);
+	Tissu::TissuSoA& LeTissu = *scene.cloths[0].tissu; // Les objets de collision sont places par rapport au premier tissu
+
+	std::vector<std::string> outputDirectories;
+	for (const Scene::Cloth& cloth : scene.cloths) {
+		outputDirectories.push_back(scene.cloths.size() == 1 ? headlessSettings.outputDirectory : headlessSettings.outputDirectory + "/" + cloth.name);
+		std::filesystem::create_directories(outputDirectories.back());
+	}
+
+	// -------------------------------------------------------------------------------------------
+	// Objets de collision (Scene::createColliders, comme la version fenetree)
+	Scene::Colliders colliders = Scene::createColliders(LeTissu, activateSphere, activateBox);
+	const std::vector<MeshGenerator::MeshGenerator*>& listeObjectCollisionable = colliders.collidables;
+
+	// -------------------------------------------------------------------------------------------
+	// Boucle de simulation (pas de sleep, pas de rendu)
+	using clock = std::chrono::high_resolution_clock;
+	auto simulationStart = clock::now();
+	int exportedFrames = 0;
+
+	for (int frame = 0; frame < headlessSettings.frames; frame++)
+	{
+		double simulationTime = frame * headlessSettings.frameDuration;
+		scene.physicCalculationSubsteped(listeObjectCollisionable, simulationTime);
+
+		if (frame % 6 == 0) {  // Meme cadence de recalcul des normales que la version fenetree
+			scene.calculationNormals();
+		}
+
+		bool isLastFrame = (frame == headlessSettings.frames - 1);
+		bool isExportFrame = headlessSettings.exportEvery > 0 && frame % headlessSettings.exportEvery == 0;
+		if (isExportFrame || isLastFrame) {
+			for (size_t c = 0; c < scene.cloths.size(); c++)
+				exportFrameAsOBJ(scene.cloths[c].tissu->positions, scene.cloths[c].tissu->EBOBuffer, outputDirectories[c], frame);
+			exportedFrames++;
+		}
+	}
+
+	std::chrono::duration<double> elapsed = clock::now() - simulationStart;
+	std::cout << "Simulated " << headlessSettings.frames << " frames (";
+	if (scene.cloths.size() == 1)
+		std::cout << LeTissu.tissuSettings.resolutionX << "x" << LeTissu.tissuSettings.resolutionY << " vertices, ";
+	else
+		std::cout << scene.cloths.size() << " cloths, " << scene.vertexCount() << " vertices, ";
+	std::cout << physicsSettings.temporalSettings.substeps << " substeps) in " << elapsed.count() << " s ("
+		<< headlessSettings.frames / elapsed.count() << " frames/s), "
+		<< exportedFrames << " frames written to " << headlessSettings.outputDirectory << std::endl;
+	return 0;
+}
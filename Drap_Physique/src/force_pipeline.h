@@ -0,0 +1,108 @@
+#ifndef FORCE_PIPELINE_H
+#define FORCE_PIPELINE_H
+
+#include <string>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------------------------------
+// Politiques des substeps specialises (Physics::accumulateForces, applicationForces, physicCalculationSubstepedFused)
+// Un Substep<Termes...> ne contient que les termes de sa liste : les tests isEnabled et le switch sur le type des objets
+// sortent de la boucle par point, le compilateur inline et fusionne les termes presents.
+// Les instanciations courantes sont rangees dans une table (index = termMask * colliderSetCount + jeu d'objets),
+// l'entree est choisie une fois par frame d'apres les reglages : une option changee dans la console
+// selectionne simplement une autre instanciation.
+
+namespace ForcePipeline
+{
+	// Forces
+	struct Gravity {};
+	struct Tension {};
+	struct Wind {};
+	struct Drag {};
+
+	// Objets de collision : chaque type a son propre tableau, parcouru sans switch
+	struct Sphere {};
+	struct Box {};
+	struct Disk {};
+	struct Cone {};
+	struct Cylinder {};
+
+	struct None {}; // Place vide (terme desactive dans SubstepOf)
+
+	template <typename... Policies>
+	struct Substep {
+		template <typename Policy>
+		static constexpr bool has = (std::is_same_v<Policy, Policies> || ...);
+	};
+
+	// Tous les types d'objets (chemins qui ne sont pas specialises, comme les tuiles en sommeil)
+	using AllColliders = Substep<Sphere, Box, Disk, Cone, Cylinder>;
+
+	// ------------------------------------------------------------------------------------------------
+	// Table des instanciations
+	enum TermFlag : int {
+		TERM_GRAVITY = 1 << 0,
+		TERM_TENSION = 1 << 1,
+		TERM_WIND    = 1 << 2,
+		TERM_DRAG    = 1 << 3,
+	};
+	constexpr int termMaskCount = 1 << 4;
+
+	// Jeux d'objets instancies : aucun, la scene de demo (spheres et boites), tous les types
+	enum class ColliderSet : int {
+		NONE,
+		SPHERE_BOX,
+		ALL,
+	};
+	constexpr int colliderSetCount = 3;
+
+	template <bool Condition, typename Policy>
+	using Optional = std::conditional_t<Condition, Policy, None>;
+
+	template <int TermMask, typename... Colliders>
+	using TermsOf = Substep<
+		Optional<(TermMask & TERM_GRAVITY) != 0, Gravity>,
+		Optional<(TermMask & TERM_TENSION) != 0, Tension>,
+		Optional<(TermMask & TERM_WIND) != 0, Wind>,
+		Optional<(TermMask & TERM_DRAG) != 0, Drag>,
+		Colliders...>;
+
+	template <int TermMask, ColliderSet Set>
+	struct SubstepOfImpl;
+	template <int TermMask>
+	struct SubstepOfImpl<TermMask, ColliderSet::NONE> { using Type = TermsOf<TermMask>; };
+	template <int TermMask>
+	struct SubstepOfImpl<TermMask, ColliderSet::SPHERE_BOX> { using Type = TermsOf<TermMask, Sphere, Box>; };
+	template <int TermMask>
+	struct SubstepOfImpl<TermMask, ColliderSet::ALL> { using Type = TermsOf<TermMask, Sphere, Box, Disk, Cone, Cylinder>; };
+
+	template <int TermMask, ColliderSet Set>
+	using SubstepOf = typename SubstepOfImpl<TermMask, Set>::Type;
+
+	constexpr int tableIndex(int termMask, ColliderSet set)
+	{
+		return termMask * colliderSetCount + static_cast<int>(set);
+	}
+
+	// Pour le log : "gravity tension wind | sphere box"
+	inline std::string describe(int index)
+	{
+		const int termMask = index / colliderSetCount;
+		const ColliderSet set = static_cast<ColliderSet>(index % colliderSetCount);
+		std::string text;
+		if (termMask & TERM_GRAVITY) text += "gravity ";
+		if (termMask & TERM_TENSION) text += "tension ";
+		if (termMask & TERM_WIND)    text += "wind ";
+		if (termMask & TERM_DRAG)    text += "drag ";
+		if (text.empty())            text = "none ";
+		switch (set)
+		{
+		case ColliderSet::NONE:       return text + "| no collider";
+		case ColliderSet::SPHERE_BOX: return text + "| sphere box";
+		case ColliderSet::ALL:        return text + "| all colliders";
+		}
+		return text;
+	}
+}
+
+#endif
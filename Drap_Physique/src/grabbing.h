@@ -71,7 +71,7 @@ namespace Grabbing
 
 	int findClosestVertexToRay(
 		const std::vector<glm::vec3>& positions,
-		const std::vector<bool>& isFixed,
+		const std::vector<uint8_t>& vertexFlags,
 		const glm::vec3& rayOrigin,
 		const glm::vec3& rayDirection,
 		float maxDistance = 0.05f)
@@ -84,7 +84,7 @@ namespace Grabbing
 		// on fait une projection du 2nd vec sur le 1er
 		// et on calcul la distance entre le point et le point au bout du vecteur projet
 		for (int i = 0; i < (int)positions.size(); ++i) {
-			if (isFixed[i]) continue; // Ignore les points dj fixs
+			if (vertexFlags[i] & Tissu::VERTEX_FIXED) continue; // Ignore les points dj fixs
 
 			const glm::vec3& point = positions[i];
 			glm::vec3 toPoint = point - rayOrigin;
@@ -123,19 +123,21 @@ namespace Grabbing
 			// Calcul du rayon souris
 			glfwGetCursorPos(window, &mouseX, &mouseY);
 			getRayFromMouse(mouseX, mouseY, screenSettings.width, screenSettings.height, tissuRenderable.viewMatrix, tissuRenderable.projectionMatrix, rayOrigin, rayDirection);
-			int idx = findClosestVertexToRay(tissu.positions, tissu.isFixed, rayOrigin, rayDirection, 0.5f);
+			int idx = findClosestVertexToRay(tissu.positions, tissu.vertexFlags, rayOrigin, rayDirection, 0.5f);
 			
 			if (idx != -1 && tissu.grabbedIndex == -1) {
 				tissu.grabbedIndex = idx;
 				glm::vec3 camPos = glm::vec3(glm::inverse(tissuRenderable.viewMatrix)[3]);
 				tissu.grabDepth = glm::length(tissu.positions[idx] - camPos); // distance relle
-				//tissu.isFixed[idx] = true;
+				//tissu.setFixed(idx, true);
 			}
+			// Cible du grab transmise a la physique (qui ne depend pas de GLFW)
+			tissu.grabTarget = rayOrigin + rayDirection * tissu.grabDepth;
 		}
 		else
 		{
 			if (tissu.grabbedIndex != -1) {
-				tissu.isFixed[tissu.grabbedIndex] = false;
+				tissu.setFixed(tissu.grabbedIndex, false);
 			}
 			tissu.grabbedIndex = -1;
 		}
@@ -0,0 +1,56 @@
+#ifndef GRID_STENCIL_H
+#define GRID_STENCIL_H
+
+#include <algorithm>
+
+// ----------------------------------------------------------------------------------------------------
+// Stencils de ressorts sur la grille reguliere du tissu (indice = x * resolutionY + y)
+// Un ressort relie (x, y) a (x + dx, y + dy) : le voisin se calcule (index + dx * resolutionY + dy), sans liste de voisins.
+// Chaque stencil ne donne que la moitie "vers l'avant" des decalages : chaque ressort est vu une seule fois.
+// Les decalages sont des parametres template : les bornes et le pas sont des constantes pour le compilateur.
+
+namespace GridStencil
+{
+	template <int DX, int DY>
+	struct Offset {
+		static_assert(DX > 0 || (DX == 0 && DY > 0), "GridStencil: Offset must point forward (dx > 0, or dx == 0 and dy > 0)");
+		static constexpr int dx = DX;
+		static constexpr int dy = DY;
+	};
+
+	template <typename... Offsets>
+	struct Stencil {};
+
+	using Structural = Stencil<Offset<1, 0>, Offset<0, 1>>;  // Voisins directs
+	using Shear = Stencil<Offset<1, 1>, Offset<1, -1>>;      // Diagonales
+	using Bending = Stencil<Offset<2, 0>, Offset<0, 2>>;     // Un point sur deux
+
+	// ------------------------------------------------------------------------------------------------
+	// Domaine d'un decalage : les points (x, y) dont le voisin (x + dx, y + dy) existe.
+	// Les lignes x sont groupees par blocs de dx lignes ; deux blocs de meme parite n'ecrivent jamais sur la meme ligne
+	// (un ressort ecrit sur les lignes x et x + dx), ils peuvent donc etre traites en parallele.
+	template <int DX, int DY>
+	struct Range {
+		static constexpr int rowsPerBlock = DX > 0 ? DX : 1;
+		static constexpr int phaseCount = DX > 0 ? 2 : 1;   // dx == 0 : chaque ligne n'ecrit que sur elle-meme
+
+		int resolutionY;
+		int rowEnd;      // x dans [0, rowEnd)
+		int columnBegin; // y dans [columnBegin, columnEnd)
+		int columnEnd;
+		int blockCount;
+		int neighborOffset;
+
+		Range(int resolutionX, int resolutionYIn)
+			: resolutionY(resolutionYIn)
+			, rowEnd(std::max(resolutionX - DX, 0))
+			, columnBegin(std::max(-DY, 0))
+			, columnEnd(std::min(resolutionYIn, resolutionYIn - DY))
+			, blockCount((std::max(resolutionX - DX, 0) + rowsPerBlock - 1) / rowsPerBlock)
+			, neighborOffset(DX * resolutionYIn + DY)
+		{
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef IMPLICIT_SOLVER_H
+#define IMPLICIT_SOLVER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <omp.h>
+
+// ----------------------------------------------------------------------------------------------------
+// Systeme lineaire creux par blocs 3x3 pour l'integration implicite (Baraff-Witkin)
+// Le motif de la matrice est celui des ressorts du tissu (CSR de TissuSoA : springOffsets / springNeighbors) :
+// un bloc diagonal par point, un bloc hors diagonale par entree du CSR.
+// Resolution par gradient conjugue preconditionne par les inverses des blocs diagonaux (block-Jacobi).
+
+namespace ImplicitSolver
+{
+	// ------------------------------------------------------------------------------------------------
+	// Matrice + second membre + vecteurs de travail du gradient conjugue
+	struct BlockSystem {
+		size_t count = 0;
+		const uint32_t* rowOffsets = nullptr;      // count + 1 entrees (springOffsets)
+		const uint32_t* columns = nullptr;         // springNeighbors
+
+		std::vector<glm::mat3> diagonal;
+		std::vector<glm::mat3> offDiagonal;        // Bloc (i, columns[k]) pour k dans [rowOffsets[i], rowOffsets[i + 1])
+		std::vector<glm::vec3> rhs;
+		std::vector<glm::vec3> solution;
+
+		// Gradient conjugue
+		std::vector<glm::mat3> inverseDiagonal;
+		std::vector<glm::vec3> residual;
+		std::vector<glm::vec3> preconditioned;
+		std::vector<glm::vec3> direction;
+		std::vector<glm::vec3> product;
+
+		int lastIterations = 0;
+		float lastResidual = 0.0f;                 // Residu relatif |r| / |b| a la fin du dernier solve
+
+		// Le motif est relu a chaque appel : les pointeurs restent valides meme si le tissu a ete deplace
+		void bindPattern(const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& neighbors)
+		{
+			if (count != offsets.size() - 1 || offDiagonal.size() != neighbors.size())
+				resize(offsets.size() - 1, neighbors.size());
+			rowOffsets = offsets.data();
+			columns = neighbors.data();
+		}
+
+		void resize(size_t vertexCount, size_t entryCount)
+		{
+			count = vertexCount;
+			diagonal.assign(count, glm::mat3(1.0f));
+			offDiagonal.assign(entryCount, glm::mat3(0.0f));
+			rhs.assign(count, glm::vec3(0.0f));
+			solution.assign(count, glm::vec3(0.0f));
+			inverseDiagonal.assign(count, glm::mat3(1.0f));
+			residual.assign(count, glm::vec3(0.0f));
+			preconditioned.assign(count, glm::vec3(0.0f));
+			direction.assign(count, glm::vec3(0.0f));
+			product.assign(count, glm::vec3(0.0f));
+		}
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// y = A x
+	inline void multiply(const BlockSystem& system, const std::vector<glm::vec3>& x, std::vector<glm::vec3>& y)
+	{
+		#pragma omp parallel for
+		for (int i = 0; i < static_cast<int>(system.count); i++) {
+			glm::vec3 sum = system.diagonal[i] * x[i];
+			for (uint32_t k = system.rowOffsets[i]; k < system.rowOffsets[i + 1]; k++)
+				sum += system.offDiagonal[k] * x[system.columns[k]];
+			y[i] = sum;
+		}
+	}
+
+	inline double dot(const std::vector<glm::vec3>& a, const std::vector<glm::vec3>& b)
+	{
+		double sum = 0.0;
+		#pragma omp parallel for reduction(+:sum)
+		for (int i = 0; i < static_cast<int>(a.size()); i++)
+			sum += static_cast<double>(glm::dot(a[i], b[i]));
+		return sum;
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Resout A x = rhs (A symetrique definie positive), x part de zero
+	// Retourne le nombre d'iterations
+	inline int solveConjugateGradient(BlockSystem& system, int maxIterations, float tolerance)
+	{
+		const int count = static_cast<int>(system.count);
+
+		// Preconditionneur block-Jacobi
+		#pragma omp parallel for
+		for (int i = 0; i < count; i++) {
+			system.inverseDiagonal[i] = glm::inverse(system.diagonal[i]);
+			system.solution[i] = glm::vec3(0.0f);
+			system.residual[i] = system.rhs[i];
+			system.preconditioned[i] = system.inverseDiagonal[i] * system.residual[i];
+			system.direction[i] = system.preconditioned[i];
+		}
+
+		double rhsNorm2 = dot(system.rhs, system.rhs);
+		double threshold2 = static_cast<double>(tolerance) * static_cast<double>(tolerance) * rhsNorm2;
+		double rz = dot(system.residual, system.preconditioned);
+		double residualNorm2 = rhsNorm2;
+
+		int iteration = 0;
+		while (iteration < maxIterations && residualNorm2 > threshold2 && rhsNorm2 > 0.0) {
+			multiply(system, system.direction, system.product);
+			double pAp = dot(system.direction, system.product);
+			if (pAp <= 0.0)
+				break; // Matrice non definie positive (ne doit pas arriver) : on garde la solution courante
+			float alpha = static_cast<float>(rz / pAp);
+
+			residualNorm2 = 0.0;
+			#pragma omp parallel for reduction(+:residualNorm2)
+			for (int i = 0; i < count; i++) {
+				system.solution[i] += alpha * system.direction[i];
+				system.residual[i] -= alpha * system.product[i];
+				residualNorm2 += static_cast<double>(glm::dot(system.residual[i], system.residual[i]));
+			}
+			iteration++;
+			if (residualNorm2 <= threshold2)
+				break;
+
+			double rzNew = 0.0;
+			#pragma omp parallel for reduction(+:rzNew)
+			for (int i = 0; i < count; i++) {
+				system.preconditioned[i] = system.inverseDiagonal[i] * system.residual[i];
+				rzNew += static_cast<double>(glm::dot(system.residual[i], system.preconditioned[i]));
+			}
+			float beta = static_cast<float>(rzNew / rz);
+			rz = rzNew;
+
+			#pragma omp parallel for
+			for (int i = 0; i < count; i++)
+				system.direction[i] = system.preconditioned[i] + beta * system.direction[i];
+		}
+
+		system.lastIterations = iteration;
+		system.lastResidual = rhsNorm2 > 0.0 ? static_cast<float>(std::sqrt(residualNorm2 / rhsNorm2)) : 0.0f;
+		return iteration;
+	}
+}
+
+#endif
@@ -2,11 +2,14 @@
 #define COLLISION_BOX_H
 
 #include <iostream>
+#include <vector>
 #include <glm/glm.hpp>
 #include <memory>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/epsilon.hpp>
 #include <glm/gtx/norm.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/string_cast.hpp>
 #include <cmath>
 
 // ----------------------------------------------------------------------------------------------------
@@ -4,13 +4,21 @@
 #include <iostream>
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
-#include <unordered_map>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <cmath>
+#include <string>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <type_traits>
 #include <omp.h>
 #include "tissuSoA.h"
-#include "glencapsulation.h"
 #include "mesh_generator.h"
-#include "grabbing.h"
+#include "simd_kernels.h"
+#include "grid_stencil.h"
+#include "force_pipeline.h"
+#include "continuous_collision.h"
 
 // ----------------------------------------------------------------------------------------------------
 
@@ -24,6 +32,10 @@ namespace Physics
 		glm::vec3 directionVector = glm::vec3(0.0f, 0.0f, -1.0f);
 		bool isEnabled = true;
 	};
+	struct SpringFamilySettings {
+		float force = 100.0f;
+		bool isEnabled = false;
+	};
 	struct TensionSettings {
 		float longeurVideRessortX = 0.1f;
 		float longeurVideRessortY = 0.1f;
@@ -31,6 +43,9 @@ namespace Physics
 		float maxTensionForce = 10.0f;
 		float damping = 200000.0f;
 		bool isEnabled = true;
+		// Ressorts supplementaires (stencils de grille) : chemins Verlet classique et implicite (force explicite) seulement
+		SpringFamilySettings shear;   // Diagonales
+		SpringFamilySettings bending; // Un point sur deux
 	};
 	struct CollisionSettings {
 		float antiClippingGap = 0.1f;
@@ -38,26 +53,100 @@ namespace Physics
 		float damping = 20000.0f;
 		bool isEnabled = true;
 	};
+	enum class SelfCollisionModel {
+		VERTEX,   // Repulsion point-point (grille hachee), seulement si minDistance est proche de l'espacement de la grille
+		TRIANGLE, // Point-triangle et arete-arete avec detection continue (BVH des triangles), minDistance = epaisseur
+	};
 	struct SelfCollisionSettings {
+		SelfCollisionModel model = SelfCollisionModel::VERTEX;
 		float minDistance = 0.04f;
 		float cellSize = 0.08f;
+		float skinDistance = 0.02f; // Marge des listes de voisins (modele VERTEX), reconstruites quand un point a bouge de skinDistance / 2
+		int excludedRings = 1; // Paires a au plus excludedRings anneaux dans la grille du tissu ignorees (0 : toutes testees)
 		bool isEnabled = false;
 	};
+	enum class WindModel {
+		VERTEX,   // Force par point : amplitude * max(0, normale . direction)
+		TRIANGLE, // Trainee et portance par triangle, a partir de la vitesse de l'air relative au triangle
+	};
 	struct WindSettings {
 		glm::vec3 directionVector = glm::vec3(1.0f, 0.0f, 0.0f);
 		float amplitude = 1.0f;
 		float oscillationFrequency = 1.0f;
 		bool isOscillate = true;
 		bool isEnabled = true;
+		WindModel model = WindModel::VERTEX;
+		// Modele TRIANGLE : air a la vitesse directionVector * airSpeed (module par l'oscillation), amplitude n'est pas utilisee
+		float airSpeed = 0.6f;
+		float airDensity = 1.0f;
+		float dragCoefficient = 1.0f;
+		float liftCoefficient = 0.5f;
+	};
+	// Frottement de l'air F = -(linear + quadratic * |v|) * v, v en unites par seconde
+	// Applique dans la mise a jour de chaque integrateur (pas de parcours en plus), de facon semi-implicite : stable quel que soit le pas
+	struct DragSettings {
+		float linear = 0.0f;
+		float quadratic = 0.0f;
+		bool isEnabled = false;
 	};
 	struct GrabSettings {
 		float force = 500.0f;
 		float damping = 200000.0f; //amortissement
 		bool isEnabled = true;
 	};
+	enum class Integrator {
+		VERLET,          // Verlet explicite, substeps pas par frame
+		IMPLICIT_EULER,  // Euler implicite (Baraff-Witkin), quelques grands pas par frame
+		XPBD,            // Contraintes de distance projetees (XPBD), quelques pas par frame
+		PROJECTIVE,      // Projective Dynamics, matrice globale prefactorisee
+	};
+	struct AdaptiveSubstepSettings {
+		bool isEnabled = false;
+		int minSubsteps = 3;
+		int maxSubsteps = 40;
+		float cflNumber = 0.02f;            // Deplacement max par substep, en fraction de la longueur a vide
+		float maxStrainPerSubstep = 0.005f; // Variation max de deformation d'un ressort par substep
+	};
 	struct TemporalSettings {
 		float dt = 1.0f / 120.0f;
 		int substeps = 20; // Les substeps sont le nombre de fois que l'on fait une simultion physique par frame | on fait des simulations plus petites, plus frequente, donc plus précices
+		Integrator integrator = Integrator::VERLET;
+		AdaptiveSubstepSettings adaptive; // Verlet seulement : substeps choisis a chaque frame, temps simule par frame inchange
+	};
+	struct ImplicitSettings {
+		int steps = 1;            // Pas implicites par frame (le temps simule par frame reste dt * sqrt(substeps), comme en Verlet)
+		int maxIterations = 50;   // Gradient conjugue
+		float tolerance = 1e-3f;  // Residu relatif |r| / |b|
+	};
+	struct XpbdSettings {
+		int substeps = 2;         // Pas XPBD par frame (le temps simule par frame reste dt * sqrt(substeps), comme en Verlet)
+		int iterations = 4;       // Passes de projection par pas
+	};
+	struct ProjectiveSettings {
+		int steps = 2;            // Pas par frame (le temps simule par frame reste dt * sqrt(substeps), comme en Verlet)
+		int iterations = 4;       // Iterations locale / globale par pas
+	};
+	struct FusedSettings {
+		bool isEnabled = false; // Un seul parcours des points par substep (forces + collisions + Verlet)
+	};
+	struct SimdSettings {
+		Simd::InstructionSet instructionSet = Simd::InstructionSet::AUTO; // AUTO : le meilleur supporte par le CPU
+		bool isEnabled = false;
+	};
+	// Type scalaire de l'etat integre et des forces (chemin Verlet classique seulement)
+	enum class Precision {
+		FLOAT,  // Tout en float (chemins SIMD, fusionne et sommeil disponibles)
+		DOUBLE, // Positions et forces en double
+		MIXED,  // Positions en double, forces en float (differences de positions et vitesses calculees en double puis arrondies)
+	};
+	struct PrecisionSettings {
+		Precision mode = Precision::FLOAT;
+	};
+	struct SleepSettings {
+		int tileSize = 8;               // Points par cote d'une tuile
+		float energyThreshold = 1e-4f;  // Energie cinetique (masse unitaire) sous laquelle un point est au repos
+		int calmSubsteps = 200;         // Substeps de repos (tuile et voisines) avant l'endormissement
+		bool isEnabled = false;
 	};
 	struct PhysicsSettings {
 		GravitySettings gravitySettings;
@@ -65,120 +154,471 @@ namespace Physics
 		CollisionSettings collisionSettings;
 		SelfCollisionSettings selfCollisionSettings;
 		TemporalSettings temporalSettings;
+		ImplicitSettings implicitSettings;
+		XpbdSettings xpbdSettings;
+		ProjectiveSettings projectiveSettings;
 		WindSettings windSettings;
+		DragSettings dragSettings;
 		GrabSettings grabSettings;
+		FusedSettings fusedSettings;
+		SimdSettings simdSettings;
+		SleepSettings sleepSettings;
+		PrecisionSettings precisionSettings;
 	};
 
+	inline const char* toString(Integrator integrator)
+	{
+		switch (integrator)
+		{
+		case Integrator::VERLET:         return "verlet";
+		case Integrator::IMPLICIT_EULER: return "implicit";
+		case Integrator::XPBD:           return "xpbd";
+		case Integrator::PROJECTIVE:     return "projective";
+		}
+		return "unknown";
+	}
+
+	inline Integrator parseIntegrator(const std::string& name)
+	{
+		if (name == "implicit") return Integrator::IMPLICIT_EULER;
+		if (name == "xpbd")     return Integrator::XPBD;
+		if (name == "projective") return Integrator::PROJECTIVE;
+		if (name != "verlet")
+			std::cerr << "ERROR: Physics: Unknown integrator \"" << name << "\", using verlet" << std::endl;
+		return Integrator::VERLET;
+	}
+
+	inline const char* toString(WindModel model)
+	{
+		switch (model)
+		{
+		case WindModel::VERTEX:   return "vertex";
+		case WindModel::TRIANGLE: return "triangle";
+		}
+		return "unknown";
+	}
+
+	inline WindModel parseWindModel(const std::string& name)
+	{
+		if (name == "triangle") return WindModel::TRIANGLE;
+		if (name != "vertex")
+			std::cerr << "ERROR: Physics: Unknown wind model \"" << name << "\", using vertex" << std::endl;
+		return WindModel::VERTEX;
+	}
+
+	inline const char* toString(SelfCollisionModel model)
+	{
+		switch (model)
+		{
+		case SelfCollisionModel::VERTEX:   return "vertex";
+		case SelfCollisionModel::TRIANGLE: return "triangle";
+		}
+		return "unknown";
+	}
+
+	inline SelfCollisionModel parseSelfCollisionModel(const std::string& name)
+	{
+		if (name == "triangle") return SelfCollisionModel::TRIANGLE;
+		if (name != "vertex")
+			std::cerr << "ERROR: Physics: Unknown self collision model \"" << name << "\", using vertex" << std::endl;
+		return SelfCollisionModel::VERTEX;
+	}
+
+	inline const char* toString(Precision precision)
+	{
+		switch (precision)
+		{
+		case Precision::FLOAT:  return "float";
+		case Precision::DOUBLE: return "double";
+		case Precision::MIXED:  return "mixed";
+		}
+		return "unknown";
+	}
+
+	inline Precision parsePrecision(const std::string& name)
+	{
+		if (name == "double") return Precision::DOUBLE;
+		if (name == "mixed")  return Precision::MIXED;
+		if (name != "float")
+			std::cerr << "ERROR: Physics: Unknown precision \"" << name << "\", using float" << std::endl;
+		return Precision::FLOAT;
+	}
+
 	// ------------------------------------------------------------------------------------------------
 	// Gravité Force 
 	void calculForceGravite(Tissu::TissuSoA& tissu, const GravitySettings& gravitySettings)
 	{
+		glm::vec3 gravity = gravitySettings.directionVector * gravitySettings.amplitude;
+		const uint8_t* vertexFlags = tissu.vertexFlags.data();
+
+		// Sans branche : le masque vaut 0 ou la masse du point (point au-dessus du sol et soumis a la gravite), force m * g
 		#pragma omp parallel for
 		for (int i = 0; i < static_cast<int>(tissu.accelerations.size()); i++) {
-			if (tissu.positions[i].z >= tissu.tissuSettings.floorHeight
-				&& tissu.isAffectedGravity[i]
-				&& !tissu.isFixed[i])
-			{
-				tissu.accelerations[i] += gravitySettings.directionVector * gravitySettings.amplitude * (1.0f / tissu.tissuSettings.mass);
-			}
+			bool isAffected = (vertexFlags[i] & Tissu::VERTEX_GRAVITY) != 0;
+			float mask = (tissu.positions[i].z >= tissu.tissuSettings.floorHeight && isAffected) ? tissu.masses[i] : 0.0f;
+			tissu.accelerations[i] += gravity * mask;
 		}
 	}
 
 	// ------------------------------------------------------------------------------------------------
 	// Tension Force 
-	glm::vec3 tensionF(
-		const glm::vec3& point1,
-		const glm::vec3& point2,
-		const glm::vec3& vel1,
-		const glm::vec3& vel2,
+	// Scalar : float partout, sauf dans le chemin de precision double (voir Main Calculation Precision)
+	template <typename Scalar>
+	glm::vec<3, Scalar> tensionF(
+		const glm::vec<3, Scalar>& point1,
+		const glm::vec<3, Scalar>& point2,
+		const glm::vec<3, Scalar>& vel1,
+		const glm::vec<3, Scalar>& vel2,
 		const TensionSettings& tensionSettings,
-		const float gap)
+		const Scalar gap)
 	{
-		glm::vec3 direction = point2 - point1;
+		using Vec3 = glm::vec<3, Scalar>;
+		Vec3 direction = point2 - point1;
 
-		float distance = glm::length(direction);
+		Scalar distance = glm::length(direction);
 
 		// Éviter la division par zéro
-		if (distance < 1e-6f) {
-			return glm::vec3(0.0f);
+		if (distance < static_cast<Scalar>(1e-6f)) {
+			return Vec3(0);
 		}
 
 		// Force de ressort (Hooke)
-		float displacement = distance - gap;
-		glm::vec3 forceSpring = tensionSettings.force * displacement * direction;
+		Scalar displacement = distance - gap;
+		Vec3 forceSpring = static_cast<Scalar>(tensionSettings.force) * displacement * direction;
 
 		// Amortissement (damping)
-		glm::vec3 relativeVelocity = vel2 - vel1;
-		float dampingForce = glm::dot(relativeVelocity, direction);
-		glm::vec3 forceDamping = tensionSettings.damping * dampingForce * direction;
+		Vec3 relativeVelocity = vel2 - vel1;
+		Scalar dampingForce = glm::dot(relativeVelocity, direction);
+		Vec3 forceDamping = static_cast<Scalar>(tensionSettings.damping) * dampingForce * direction;
 
 		return forceSpring + forceDamping;
 	}
 
-	void calculForceTension(Tissu::TissuSoA& tissu, const TensionSettings& tensionSettings) {
-		#pragma omp parallel for
-		for (int i = 0; i < static_cast<int>(tissu.accelerations.size()); i++) {
-			glm::vec3 forceTotale(0.0f);  //C'est une acceleration
-			glm::vec3 p1 = tissu.positions[i];
-			glm::vec3 vel1 = tissu.vitesses[i];
-			for (size_t j = 0; j < tissu.linkedVertices[i].size(); j++) {
-				glm::vec3 p2 = tissu.positions[std::get<size_t>(tissu.linkedVertices[i][j])];
-				glm::vec3 vel2 = tissu.vitesses[std::get<size_t>(tissu.linkedVertices[i][j])];
+	// Noyau de grille (grid_stencil.h) : le voisin d'un point est calcule (index + dx * resolutionY + dy), aucune topologie lue.
+	// Chaque ressort est calcule une seule fois et applique aux deux extremites : tensionF est antisymetrique.
+	// Les bornes des boucles excluent les bords, il n'y a aucun test dans la boucle interieure.
+	// Meme noyau pour une numerotation TILED ou MORTON (tissuSoA.h) : les indices sont lus dans gridToIndex.
+	// Les lignes sont groupees par blocs de orderingTileSize lignes (>= dx), chaque bloc est parcouru tuile par tuile :
+	// une tuile alignee est contigue en memoire dans les deux numerotations. Blocs pairs puis impairs, comme Range.
+	template <int DX, int DY>
+	void applyGridSpringOrdered(Tissu::TissuSoA& tissu, const TensionSettings& springSettings, float restLength)
+	{
+		constexpr int blockSize = Tissu::orderingTileSize;
+		static_assert(DX <= blockSize, "GridStencil: offset longer than an ordering tile");
+		const int resX = static_cast<int>(tissu.tissuSettings.resolutionX);
+		const int resY = static_cast<int>(tissu.tissuSettings.resolutionY);
+		const int blockCount = (resX + blockSize - 1) / blockSize;
+		const uint32_t* cellToIndex = tissu.gridToIndex.data();
+
+		#pragma omp parallel
+		for (int phase = 0; phase < 2; phase++) {
+			#pragma omp for
+			for (int block = phase; block < blockCount; block += 2) {
+				const int xBegin = block * blockSize;
+				const int xEnd = std::min(xBegin + blockSize, resX - DX);
+				for (int yTile = 0; yTile < resY; yTile += blockSize) {
+					const int yBegin = std::max(yTile, -DY);
+					const int yEnd = std::min({ yTile + blockSize, resY, resY - DY });
+					for (int x = xBegin; x < xEnd; x++) {
+						for (int y = yBegin; y < yEnd; y++) {
+							const size_t a = cellToIndex[static_cast<size_t>(x) * resY + y];
+							const size_t b = cellToIndex[static_cast<size_t>(x + DX) * resY + (y + DY)];
+
+							glm::vec3 force = tensionF(tissu.positions[a], tissu.positions[b], tissu.vitesse(a), tissu.vitesse(b), springSettings, restLength);
+
+							if (glm::length(force) > springSettings.maxTensionForce) {
+								force = glm::normalize(force) * springSettings.maxTensionForce;
+							}
+
+							tissu.accelerations[a] += force;
+							tissu.accelerations[b] -= force;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	template <int DX, int DY>
+	void applyGridSpring(Tissu::TissuSoA& tissu, const TensionSettings& springSettings, float restLength)
+	{
+		if (tissu.tissuSettings.ordering != Tissu::VertexOrdering::ROW_MAJOR) {
+			applyGridSpringOrdered<DX, DY>(tissu, springSettings, restLength);
+			return;
+		}
 
-				glm::vec3 force = tensionF(p1, p2, vel1, vel2, tensionSettings, std::get<float>(tissu.linkedVertices[i][j]));
+		using Range = GridStencil::Range<DX, DY>;
+		const Range range(static_cast<int>(tissu.tissuSettings.resolutionX), static_cast<int>(tissu.tissuSettings.resolutionY));
+
+		#pragma omp parallel
+		for (int phase = 0; phase < Range::phaseCount; phase++) {
+			#pragma omp for
+			for (int block = phase; block < range.blockCount; block += Range::phaseCount) {
+				const int rowBegin = block * Range::rowsPerBlock;
+				const int rowEnd = std::min(rowBegin + Range::rowsPerBlock, range.rowEnd);
+				for (int x = rowBegin; x < rowEnd; x++) {
+					const size_t rowStart = static_cast<size_t>(x) * range.resolutionY;
+					for (int y = range.columnBegin; y < range.columnEnd; y++) {
+						const size_t a = rowStart + y;
+						const size_t b = a + range.neighborOffset;
+
+						glm::vec3 force = tensionF(tissu.positions[a], tissu.positions[b], tissu.vitesse(a), tissu.vitesse(b), springSettings, restLength);
+
+						if (glm::length(force) > springSettings.maxTensionForce) {
+							force = glm::normalize(force) * springSettings.maxTensionForce;
+						}
 
-				if (glm::length(force) > tensionSettings.maxTensionForce) {
-					force = glm::normalize(force) * tensionSettings.maxTensionForce;
+						//C'est une force : l'integration la multiplie par invMasses (nulle sur un point fixe)
+						tissu.accelerations[a] += force;
+						tissu.accelerations[b] -= force;
+					}
 				}
+			}
+		}
+	}
+
+	template <int DX, int DY>
+	inline float gridSpringRestLength(const Tissu::TissuSoA& tissu)
+	{
+		const float gapX = tissu.tissuSettings.gapPointStartX;
+		const float gapY = tissu.tissuSettings.gapPointStartY;
+		return std::sqrt(static_cast<float>(DX * DX) * gapX * gapX + static_cast<float>(DY * DY) * gapY * gapY);
+	}
+
+	template <typename... Offsets>
+	void applyGridStencil(GridStencil::Stencil<Offsets...>, Tissu::TissuSoA& tissu, const TensionSettings& springSettings)
+	{
+		(applyGridSpring<Offsets::dx, Offsets::dy>(tissu, springSettings, gridSpringRestLength<Offsets::dx, Offsets::dy>(tissu)), ...);
+	}
+
+	// Meme noyau restreint a une tuile (x dans [xBegin, xEnd), y dans [yBegin, yEnd)), forces cumulees dans tileForces
+	// (indice local (x - xBegin) * tileStride + (y - yBegin)). Un ressort interne a la tuile est calcule une fois ;
+	// un ressort qui sort de la tuile n'est applique qu'au point de la tuile (il est recalcule par la tuile voisine).
+	template <int DX, int DY>
+	void accumulateTileSpring(const Tissu::TissuSoA& tissu, const TensionSettings& springSettings, float restLength,
+		int xBegin, int xEnd, int yBegin, int yEnd, int tileStride, glm::vec3* tileForces)
+	{
+		const int resX = static_cast<int>(tissu.tissuSettings.resolutionX);
+		const int resY = static_cast<int>(tissu.tissuSettings.resolutionY);
 
-				forceTotale += force;
+		auto boundedTension = [&](size_t a, size_t b) {
+			glm::vec3 force = tensionF(tissu.positions[a], tissu.positions[b], tissu.vitesse(a), tissu.vitesse(b), springSettings, restLength);
+			if (glm::length(force) > springSettings.maxTensionForce) {
+				force = glm::normalize(force) * springSettings.maxTensionForce;
 			}
-			if (!tissu.isFixed[i]) {
-				tissu.accelerations[i] += forceTotale;// / tissu.masses[i];
+			return force;
+		};
+
+		for (int x = xBegin; x < xEnd; x++) {
+			for (int y = yBegin; y < yEnd; y++) {
+				const size_t i = tissu.gridIndex(x, y);
+				const int local = (x - xBegin) * tileStride + (y - yBegin);
+				// Vers l'avant (x + dx, y + dy)
+				const int nx = x + DX;
+				const int ny = y + DY;
+				if (nx < resX && ny >= 0 && ny < resY) {
+					glm::vec3 force = boundedTension(i, tissu.gridIndex(nx, ny));
+					tileForces[local] += force;
+					if (nx < xEnd && ny >= yBegin && ny < yEnd)
+						tileForces[(nx - xBegin) * tileStride + (ny - yBegin)] -= force;
+				}
+				// Vers l'arriere, seulement si (x - dx, y - dy) est hors de la tuile (sinon deja vu vers l'avant)
+				const int px = x - DX;
+				const int py = y - DY;
+				if (px >= 0 && py >= 0 && py < resY && (px < xBegin || py < yBegin || py >= yEnd))
+					tileForces[local] += boundedTension(i, tissu.gridIndex(px, py));
 			}
 		}
+	}
+
+	template <typename... Offsets>
+	void accumulateTileStencil(GridStencil::Stencil<Offsets...>, const Tissu::TissuSoA& tissu, const TensionSettings& springSettings,
+		int xBegin, int xEnd, int yBegin, int yEnd, int tileStride, glm::vec3* tileForces)
+	{
+		(accumulateTileSpring<Offsets::dx, Offsets::dy>(tissu, springSettings, gridSpringRestLength<Offsets::dx, Offsets::dy>(tissu),
+			xBegin, xEnd, yBegin, yEnd, tileStride, tileForces), ...);
+	}
+
+	// Ressorts structurels, plus cisaillement et flexion s'ils sont actives (meme amortissement et meme borne, raideur propre)
+	void calculForceTension(Tissu::TissuSoA& tissu, const TensionSettings& tensionSettings) {
+		applyGridStencil(GridStencil::Structural{}, tissu, tensionSettings);
+		if (tensionSettings.shear.isEnabled) {
+			TensionSettings shearSettings = tensionSettings;
+			shearSettings.force = tensionSettings.shear.force;
+			applyGridStencil(GridStencil::Shear{}, tissu, shearSettings);
+		}
+		if (tensionSettings.bending.isEnabled) {
+			TensionSettings bendingSettings = tensionSettings;
+			bendingSettings.force = tensionSettings.bending.force;
+			applyGridStencil(GridStencil::Bending{}, tissu, bendingSettings);
+		}
 	};
 
 	// ------------------------------------------------------------------------------------------------
 	// Wind Force 
-	void calculForceWind(Tissu::TissuSoA& tissu, const WindSettings& windSettings) {
+	// Variation du vent dans [0, 1] (1 sans oscillation) : un seul sinus par frame, calcule hors des boucles sur les points
+	inline float windOscillation(const WindSettings& windSettings, double simulationTime)
+	{
+		if (!windSettings.isOscillate)
+			return 1.0f;
+		float omega = glm::two_pi<float>() * windSettings.oscillationFrequency; // 2πf
+		return 0.5f * std::sin(omega * static_cast<float>(simulationTime)) + 0.5f;
+	}
+
+	// Modele VERTEX
+	void calculForceWind(Tissu::TissuSoA& tissu, const WindSettings& windSettings, double simulationTime) {
 		if (!windSettings.isEnabled)
 			return;
-		glm::vec3 dir = glm::normalize(windSettings.directionVector);
+		const glm::vec3 dir = glm::normalize(windSettings.directionVector);
+		const glm::vec3 windBase = dir * windSettings.amplitude;
+		const float variation = windOscillation(windSettings, simulationTime);
 
 		#pragma omp parallel for
 		for (int i = 0; i < static_cast<int>(tissu.positions.size()); i++) {
 			// Projection de la normale sur la direction du vent
 			float dot = glm::dot(tissu.normals[i], dir);
 			float surfaceFactor = glm::clamp(dot, 0.0f, 1.0f); // optionnel : unilatéral
+			tissu.accelerations[i] += windBase * surfaceFactor * variation;
+		}
 
-			float variation = 1.0f;
-			if (windSettings.isOscillate)
-			{
-				float omega = glm::two_pi<float>() * windSettings.oscillationFrequency; // 2πf
-				variation = 0.5f * std::sin(omega * glfwGetTime()) + 0.5f;          // ∈ [0,1]
-			}
-			glm::vec3 force = dir * windSettings.amplitude * surfaceFactor * variation;
-			tissu.accelerations[i] += force; // / tissu.masses[i];
+	}
+
+	// Modele TRIANGLE
+	// Chaque triangle voit l'air a la vitesse relative v = air - vitesse moyenne de ses 3 points (vitesse() / substepDuration).
+	// Avec n la normale unitaire et A l'aire du triangle :
+	//  - trainee  = 0.5 * rho * Cd * A * |n . v| * v                            (le long de v, surface exposee A * |cos|)
+	//  - portance = 0.5 * rho * Cl * A * (n . v) * (|v| * n - (n . v) * v / |v|)  (perpendiculaire a v, en sin(2 * angle))
+	// Les deux ne dependent pas du sens de la normale. La force du triangle est repartie par tiers sur ses points.
+	// Ecrites avec N = produit vectoriel des aretes (n * 2A) : une seule racine par triangle (Simd::AeroWindParams).
+
+	// Scalaires de la frame, partages par le noyau generique et le noyau SIMD
+	inline Simd::AeroWindParams aeroWindParams(const WindSettings& windSettings, float substepDuration, double simulationTime)
+	{
+		const glm::vec3 airVelocity = glm::normalize(windSettings.directionVector) * (windSettings.airSpeed * windOscillation(windSettings, simulationTime));
+		return Simd::AeroWindParams{
+			airVelocity.x, airVelocity.y, airVelocity.z,
+			1.0f / (3.0f * substepDuration),
+			0.25f * windSettings.airDensity * windSettings.dragCoefficient,
+			0.25f * windSettings.airDensity * windSettings.liftCoefficient,
+			1.0f / 3.0f };
+	}
+
+	inline glm::vec3 aeroForce(const glm::vec3& areaNormal, const glm::vec3& relative, const Simd::AeroWindParams& params)
+	{
+		const float flux = glm::dot(areaNormal, relative);
+		const float speed2 = glm::dot(relative, relative);
+		const float invNormSpeed = 1.0f / std::sqrt(std::max(glm::dot(areaNormal, areaNormal) * speed2, 1e-30f));
+		const float liftScale = params.liftFactor * flux * invNormSpeed;
+		return (params.dragFactor * std::abs(flux) - liftScale * flux) * relative + (liftScale * speed2) * areaNormal;
+	}
+
+	// Noyau generique (toute numerotation des points, tous les integrateurs) :
+	// passe 1 sur les triangles, sans branche, chacun n'ecrit que sa force ; passe 2 sur les points, qui additionnent les forces
+	// de leurs triangles (CSR triangleOffsets / vertexTriangles) : pas d'ecriture concurrente, somme toujours dans le meme ordre.
+	// Le noyau vectorise du chemin SIMD (Simd::Impl::windTriangles) lit les triangles de la grille sans indices.
+	// PositionScalar / ForceScalar : float, ou l'etat double du chemin de precision (les differences sont faites en double).
+	template <typename PositionScalar, typename ForceScalar>
+	void calculForceWindTriangles(Tissu::TissuSoA& tissu,
+		const std::vector<glm::vec<3, PositionScalar>>& positions,
+		const std::vector<glm::vec<3, PositionScalar>>& positionsOld,
+		const WindSettings& windSettings, float substepDuration, double simulationTime,
+		std::vector<glm::vec<3, ForceScalar>>& accelerations)
+	{
+		const Simd::AeroWindParams params = aeroWindParams(windSettings, substepDuration, simulationTime);
+		const glm::vec3 airVelocity(params.airVelocityX, params.airVelocityY, params.airVelocityZ);
+
+		const unsigned int* triangles = tissu.EBOBuffer.data();
+		glm::vec3* triangleForces = tissu.triangleForces.data();
+		const int triangleCount = static_cast<int>(tissu.triangleForces.size());
+
+		#pragma omp parallel for
+		for (int t = 0; t < triangleCount; t++) {
+			const unsigned int i0 = triangles[3 * t];
+			const unsigned int i1 = triangles[3 * t + 1];
+			const unsigned int i2 = triangles[3 * t + 2];
+
+			const glm::vec3 edge1(positions[i1] - positions[i0]);
+			const glm::vec3 edge2(positions[i2] - positions[i0]);
+			const glm::vec3 displacement((positions[i0] - positionsOld[i0]) + (positions[i1] - positionsOld[i1]) + (positions[i2] - positionsOld[i2]));
+			triangleForces[t] = aeroForce(glm::cross(edge1, edge2), airVelocity - displacement * params.velocityScale, params);
+		}
+
+		const uint32_t* offsets = tissu.triangleOffsets.data();
+		const uint32_t* vertexTriangles = tissu.vertexTriangles.data();
+		#pragma omp parallel for
+		for (int i = 0; i < static_cast<int>(positions.size()); i++) {
+			glm::vec3 force(0.0f);
+			for (uint32_t k = offsets[i]; k < offsets[i + 1]; k++)
+				force += triangleForces[vertexTriangles[k]];
+			accelerations[i] += glm::vec<3, ForceScalar>(force * params.vertexShare);
+		}
+	}
+
+	// Duree d'un substep : vitesse() est un deplacement sur cette duree, dans tous les integrateurs
+	inline float substepDuration(const TemporalSettings& temporalSettings)
+	{
+		return temporalSettings.dt / std::sqrt(static_cast<float>(temporalSettings.substeps));
+	}
+
+	// Vent du modele choisi dans accelerations (forces en float)
+	void applyWind(Tissu::TissuSoA& tissu, const WindSettings& windSettings, const TemporalSettings& temporalSettings, double simulationTime)
+	{
+		if (windSettings.model == WindModel::TRIANGLE)
+			calculForceWindTriangles(tissu, tissu.positions, tissu.positionsOld, windSettings, substepDuration(temporalSettings), simulationTime, tissu.accelerations);
+		else
+			calculForceWind(tissu, windSettings, simulationTime);
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Air Drag
+	// Sur un pas de duree h : v' = v / (1 + h * (linear + quadratic * |v|) / masse). Avec le deplacement du pas d = h * v,
+	// comme vitesse() : d' = d / (1 + (linear * h + quadratic * |d|) * invMass). Les deux termes sont calcules une fois par frame,
+	// la masse est celle du point (TissuSoA::invMasses, 0 sur un point fixe : facteur 1).
+	struct DragTerms {
+		float linear = 0.0f;    // linear * h
+		float quadratic = 0.0f; // quadratic
+		bool isEnabled = false;
+
+		// Facteur applique a un deplacement de longueur displacementLength (1 sans frottement)
+		template <typename Scalar>
+		Scalar factor(Scalar displacementLength, float invMass) const
+		{
+			return isEnabled ? Scalar(1) / (Scalar(1) + (Scalar(linear) + Scalar(quadratic) * displacementLength) * Scalar(invMass)) : Scalar(1);
 		}
 
+		template <typename Scalar>
+		glm::vec<3, Scalar> apply(const glm::vec<3, Scalar>& displacement, float invMass) const
+		{
+			return isEnabled ? damp(displacement, invMass) : displacement;
+		}
+
+		// Sans tester isEnabled (substep fusionne specialise avec ForcePipeline::Drag)
+		template <typename Scalar>
+		glm::vec<3, Scalar> damp(const glm::vec<3, Scalar>& displacement, float invMass) const
+		{
+			return displacement * (Scalar(1) / (Scalar(1) + (Scalar(linear) + Scalar(quadratic) * glm::length(displacement)) * Scalar(invMass)));
+		}
+	};
+
+	inline DragTerms dragTerms(const DragSettings& dragSettings, float stepDuration)
+	{
+		return DragTerms{ dragSettings.linear * stepDuration, dragSettings.quadratic, dragSettings.isEnabled };
 	}
 
 	// ------------------------------------------------------------------------------------------------
 	// Sphere Collision
-	void applySphereCollisionResponse(Tissu::TissuSoA& tissu, const glm::vec3& sphereCenter, const float& sphereRadius, const CollisionSettings& collisionSettings) {
-		#pragma omp parallel for
-		for (int i = 0; i < static_cast<int>(tissu.positions.size()); i++) {
-			glm::vec3 direction = tissu.positions[i] - sphereCenter;
-			float distance = glm::length(direction);
+	// Reponse d'un seul point (les chemins de calcul parcourent les objets pre-calcules, voir ColliderShape)
+	inline glm::vec3 sphereCollisionForce(const glm::vec3& position, const glm::vec3& sphereCenter, float sphereRadius, const CollisionSettings& collisionSettings)
+	{
+		glm::vec3 direction = position - sphereCenter;
+		float distance = glm::length(direction);
 
-			if (distance <= sphereRadius + collisionSettings.antiClippingGap) {
-				float penetration = sphereRadius + collisionSettings.antiClippingGap - distance;
-				glm::vec3 normal = (distance > 0.0f) ? glm::normalize(direction) : glm::vec3(0, 1, 0);
-				glm::vec3 reaction_force = normal * penetration * collisionSettings.stiffness;
-				tissu.accelerations[i] += reaction_force;
-			}
+		if (distance <= sphereRadius + collisionSettings.antiClippingGap) {
+			float penetration = sphereRadius + collisionSettings.antiClippingGap - distance;
+			glm::vec3 normal = (distance > 0.0f) ? glm::normalize(direction) : glm::vec3(0, 1, 0);
+			return normal * penetration * collisionSettings.stiffness;
 		}
+		return glm::vec3(0.0f);
 	}
 
 	// ------------------------------------------------------------------------------------------------
@@ -189,186 +629,386 @@ namespace Physics
 		return glm::length(glm::max(d, glm::vec3(0.0f))) + std::min(glm::max(d.x, glm::max(d.y, d.z)), 0.0f);
 	}
 
-	void applyBoxCollisionResponse_SDF(
-		Tissu::TissuSoA& tissu,
-		const glm::vec3& boxCenter,
-		const glm::vec3& boxSize,
-		const glm::vec3& rotationAxis,
-		const CollisionSettings& collisionSettings)
+	inline glm::mat3 boxRotationMatrix(const glm::vec3& rotationAxis)
 	{
 		glm::mat3 rotationMatrix = glm::mat3(1.0f);
 		if (glm::length(rotationAxis) > 1e-6f) {
 			rotationMatrix = glm::mat3_cast(glm::angleAxis(glm::radians(0.0f), glm::normalize(rotationAxis)));
 		}
+		return rotationMatrix;
+	}
 
-		glm::mat3 invRotation = glm::transpose(rotationMatrix);
-		glm::vec3 halfSize = (boxSize + glm::vec3(collisionSettings.antiClippingGap * 5.0f)) * 0.5f; // *0.5 car moitierbox // *10.0 car l'anticlipping doit etre plus grand pour une boite
-
-		#pragma omp parallel for
-		for (int i = 0; i < static_cast<int>(tissu.positions.size()); i++) {
-			glm::vec3 localPos = invRotation * (tissu.positions[i] - boxCenter);
-			float dist = sdfBox(localPos, halfSize);
+	inline glm::vec3 boxCollisionHalfSize(const glm::vec3& boxSize, const CollisionSettings& collisionSettings)
+	{
+		return (boxSize + glm::vec3(collisionSettings.antiClippingGap * 5.0f)) * 0.5f; // *0.5 car moitierbox // *10.0 car l'anticlipping doit etre plus grand pour une boite
+	}
 
-			if (dist < 0.0f) // Point à l’intérieur
-			{
-				// Approximation du gradient (normal) via dérivée centrale
-				float h = 0.001f;
-				glm::vec3 normal = glm::normalize(glm::vec3(
-					sdfBox(localPos + glm::vec3(h, 0, 0), halfSize) - sdfBox(localPos - glm::vec3(h, 0, 0), halfSize),
-					sdfBox(localPos + glm::vec3(0, h, 0), halfSize) - sdfBox(localPos - glm::vec3(0, h, 0), halfSize),
-					sdfBox(localPos + glm::vec3(0, 0, h), halfSize) - sdfBox(localPos - glm::vec3(0, 0, h), halfSize)
-				));
+	inline glm::vec3 boxCollisionForce(
+		const glm::vec3& position,
+		const glm::vec3& boxCenter,
+		const glm::mat3& rotationMatrix,
+		const glm::mat3& invRotation,
+		const glm::vec3& halfSize,
+		const CollisionSettings& collisionSettings)
+	{
+		glm::vec3 localPos = invRotation * (position - boxCenter);
+		float dist = sdfBox(localPos, halfSize);
 
-				glm::vec3 worldNormal = rotationMatrix * normal;
-				tissu.accelerations[i] += worldNormal * (-dist) * collisionSettings.stiffness;
-			}
+		if (dist < 0.0f) // Point à l’intérieur
+		{
+			// Approximation du gradient (normal) via dérivée centrale
+			float h = 0.001f;
+			glm::vec3 normal = glm::normalize(glm::vec3(
+				sdfBox(localPos + glm::vec3(h, 0, 0), halfSize) - sdfBox(localPos - glm::vec3(h, 0, 0), halfSize),
+				sdfBox(localPos + glm::vec3(0, h, 0), halfSize) - sdfBox(localPos - glm::vec3(0, h, 0), halfSize),
+				sdfBox(localPos + glm::vec3(0, 0, h), halfSize) - sdfBox(localPos - glm::vec3(0, 0, h), halfSize)
+			));
+
+			glm::vec3 worldNormal = rotationMatrix * normal;
+			return worldNormal * (-dist) * collisionSettings.stiffness;
 		}
+		return glm::vec3(0.0f);
 	}
 
 	// ------------------------------------------------------------------------------------------------
 	// Cylinder Collision (IA Genererated - Won't take credit for this)
-	void applyCylinderCollisionResponse(
-		Tissu::TissuSoA& tissu,
+	inline glm::vec3 cylinderCollisionForce(
+		const glm::vec3& pos,
+		const glm::vec3& velocity,
 		const glm::vec3& cylinderCenter,
-		const float& cylinderRadius,
-		const float& cylinderHeight,
-		const glm::vec3& axisDirection, // direction centrale du cylindre (doit être normalisée)
-		const CollisionSettings& collisionSettings
-	) {
-		glm::vec3 axis = glm::normalize(axisDirection);
-		float halfHeight = cylinderHeight * 0.5f;
-		float radiusWithGap2 = glm::pow(cylinderRadius + collisionSettings.antiClippingGap, 2.0f);
-
-		#pragma omp parallel for
-		for (int i = 0; i < static_cast<int>(tissu.positions.size()); ++i) {
-			glm::vec3 pos = tissu.positions[i];
-			glm::vec3 posOld = tissu.positionsOld[i];
-			glm::vec3 velocity = pos - posOld;
-
-			// Vector from cylinder center to point
-			glm::vec3 toPoint = pos - cylinderCenter;
+		float cylinderRadius,
+		float halfHeight,
+		float radiusWithGap2,
+		const glm::vec3& axis,           // normalisée
+		const CollisionSettings& collisionSettings)
+	{
+		// Vector from cylinder center to point
+		glm::vec3 toPoint = pos - cylinderCenter;
 
-			// Projection on cylinder axis
-			float heightAlongAxis = glm::dot(toPoint, axis);
+		// Projection on cylinder axis
+		float heightAlongAxis = glm::dot(toPoint, axis);
 
-			// Check if inside height
-			if (heightAlongAxis < -halfHeight || heightAlongAxis > halfHeight) continue;
+		// Check if inside height
+		if (heightAlongAxis < -halfHeight || heightAlongAxis > halfHeight) return glm::vec3(0.0f);
 
-			// Closest point on axis
-			glm::vec3 axisPoint = cylinderCenter + axis * heightAlongAxis;
-			glm::vec3 radialVec = pos - axisPoint;
-			float radialDist2 = glm::dot(radialVec, radialVec);
+		// Closest point on axis
+		glm::vec3 axisPoint = cylinderCenter + axis * heightAlongAxis;
+		glm::vec3 radialVec = pos - axisPoint;
+		float radialDist2 = glm::dot(radialVec, radialVec);
 
-			if (radialDist2 < radiusWithGap2) {
-				float penetration = (cylinderRadius + collisionSettings.antiClippingGap) - glm::sqrt(radialDist2);
-				glm::vec3 normal = (radialDist2 > 0.0f) ? glm::normalize(radialVec) : glm::vec3(1, 0, 0);
+		if (radialDist2 < radiusWithGap2) {
+			float penetration = (cylinderRadius + collisionSettings.antiClippingGap) - glm::sqrt(radialDist2);
+			glm::vec3 normal = (radialDist2 > 0.0f) ? glm::normalize(radialVec) : glm::vec3(1, 0, 0);
 
-				// Réaction ressort
-				glm::vec3 reaction_force = normal * penetration * collisionSettings.stiffness/1000;
-				tissu.accelerations[i] += reaction_force;
+			// Réaction ressort
+			glm::vec3 reaction_force = normal * penetration * collisionSettings.stiffness/1000.0f;
 
-				// Freinage normal (empêche rebond)
-				glm::vec3 normal_velocity = glm::dot(velocity, normal) * normal;
-				glm::vec3 damping_force = -collisionSettings.damping * normal_velocity;
-				tissu.accelerations[i] += damping_force;
-			}
+			// Freinage normal (empêche rebond)
+			glm::vec3 normal_velocity = glm::dot(velocity, normal) * normal;
+			glm::vec3 damping_force = -collisionSettings.damping * normal_velocity;
+			return reaction_force + damping_force;
 		}
+		return glm::vec3(0.0f);
 	}
 
 	// ------------------------------------------------------------------------------------------------
 	// Cone Collision (IA Genererated - Won't take credit for this)
-	void applyConeCollisionResponse(
-		Tissu::TissuSoA& tissu,
+	inline glm::vec3 coneCollisionForce(
+		const glm::vec3& pos,
+		const glm::vec3& velocity,
 		const glm::vec3& coneTip,
-		const glm::vec3& axisDirection,  // direction du cône (normalisée) : de la pointe vers la base
-		float height,                    // hauteur totale du cône
-		float baseRadius,                // rayon à la base
-		const CollisionSettings& collisionSettings
-	) {
-		glm::vec3 axis = glm::normalize(axisDirection);
-		float sinAngle = baseRadius / glm::sqrt(baseRadius * baseRadius + height * height); // sin(θ) du cône
-		float cosAngle = glm::sqrt(1 - sinAngle * sinAngle);
-		float tanAngle = baseRadius / height;
-		float antiClip = collisionSettings.antiClippingGap;
-
-		#pragma omp parallel for
-		for (int i = 0; i < static_cast<int>(tissu.positions.size()); ++i) {
-			glm::vec3& pos = tissu.positions[i];
-			glm::vec3 velocity = tissu.positions[i] - tissu.positionsOld[i];
-
-			glm::vec3 toPoint = pos - coneTip;
-			float projLen = glm::dot(toPoint, axis);
+		const glm::vec3& axis,           // normalisée, de la pointe vers la base
+		float height,
+		float tanAngle,
+		const CollisionSettings& collisionSettings)
+	{
+		glm::vec3 toPoint = pos - coneTip;
+		float projLen = glm::dot(toPoint, axis);
 
-			if (projLen < 0.0f || projLen > height) continue; // en dehors de la hauteur du cône
+		if (projLen < 0.0f || projLen > height) return glm::vec3(0.0f); // en dehors de la hauteur du cône
 
-			glm::vec3 radial = toPoint - projLen * axis;
-			float radialDist = glm::length(radial);
-			float maxRadiusAtHeight = projLen * tanAngle + antiClip;
+		glm::vec3 radial = toPoint - projLen * axis;
+		float radialDist = glm::length(radial);
+		float maxRadiusAtHeight = projLen * tanAngle + collisionSettings.antiClippingGap;
 
-			if (radialDist < maxRadiusAtHeight) {
-				// Il y a contact avec la paroi du cône
-				float penetration = maxRadiusAtHeight - radialDist;
-				glm::vec3 normal = (radialDist > 0.0f) ? glm::normalize(radial) : glm::vec3(1, 0, 0);
+		if (radialDist < maxRadiusAtHeight) {
+			// Il y a contact avec la paroi du cône
+			float penetration = maxRadiusAtHeight - radialDist;
+			glm::vec3 normal = (radialDist > 0.0f) ? glm::normalize(radial) : glm::vec3(1, 0, 0);
 
-				// Force de réaction
-				glm::vec3 reaction = normal * penetration * collisionSettings.stiffness;
-				tissu.accelerations[i] += reaction;
+			// Force de réaction
+			glm::vec3 reaction = normal * penetration * collisionSettings.stiffness;
 
-				// Freinage (anti-rebond)
-				glm::vec3 normalVel = glm::dot(velocity, normal) * normal;
-				glm::vec3 damping = -collisionSettings.damping * normalVel;
-				tissu.accelerations[i] += damping;
-			}
+			// Freinage (anti-rebond)
+			glm::vec3 normalVel = glm::dot(velocity, normal) * normal;
+			glm::vec3 damping = -collisionSettings.damping * normalVel;
+			return reaction + damping;
 		}
+		return glm::vec3(0.0f);
 	}
 
 	// ------------------------------------------------------------------------------------------------
 	// Disk Collision
-	void applyDiskCollisionResponse(
-		Tissu::TissuSoA& tissu,
+	inline glm::vec3 diskCollisionForce(
+		const glm::vec3& pos,
+		const glm::vec3& velocity,
 		const glm::vec3& diskCenter,
-		const float& diskRadius,
-		const glm::vec3& rotationAxis,
-		const CollisionSettings& collisionSettings) {
-		glm::vec3 diskNormal = glm::normalize(rotationAxis);
-		float radiusWithGap2 = glm::pow(diskRadius + collisionSettings.antiClippingGap, 2.0f);
+		const glm::vec3& diskNormal,     // normalisée
+		float radiusWithGap2,
+		const CollisionSettings& collisionSettings)
+	{
+		glm::vec3 toPoint = pos - diskCenter;
 
-		#pragma omp parallel for
-		for (int i = 0; i < static_cast<int>(tissu.positions.size()); i++) {
-			glm::vec3 pos = tissu.positions[i];
-			glm::vec3 posOld = tissu.positionsOld[i];
-			glm::vec3 velocity = pos - posOld;
-			glm::vec3 toPoint = pos - diskCenter;
+		// Distance signée au plan du disque
+		float distToPlane = glm::dot(toPoint, diskNormal);
+
+		// Projection pour test radial
+		glm::vec3 projected = pos - distToPlane * diskNormal;
+		float radialDist2 = glm::length2(projected - diskCenter);
+
+		if (distToPlane < 0.0f && radialDist2 <= radiusWithGap2) {
+			float penetration = -distToPlane + collisionSettings.antiClippingGap;
+
+			// Force de réaction (type ressort)
+			glm::vec3 reaction_force = diskNormal * penetration * collisionSettings.stiffness/10000.0f;
+
+			// Force de freinage (amortissement vertical extrême)
+			glm::vec3 vertical_velocity = glm::dot(velocity, diskNormal) * diskNormal;
+			glm::vec3 damping_force = -collisionSettings.damping * vertical_velocity;
+			return reaction_force + damping_force;
+		}
+		return glm::vec3(0.0f);
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Objet de collision pre-calcule (repere, rayons au carre...) : une fois par frame pour le substep fusionne
+	struct ColliderShape {
+		MeshGenerator::PrimitiveType type;
+		glm::vec3 center;
+		glm::vec3 axis;               // Normalise (cylindre, cone, disque)
+		glm::mat3 rotation;           // Boite
+		glm::mat3 invRotation;        // Boite
+		glm::vec3 halfSize;           // Boite, anti-clipping compris
+		float radius = 0.0f;
+		float height = 0.0f;          // Cone : hauteur totale, cylindre : demi-hauteur
+		float radiusWithGap2 = 0.0f;  // Cylindre, disque
+		float tanAngle = 0.0f;        // Cone
+	};
+
+	std::vector<ColliderShape> buildColliderShapes(const std::vector<MeshGenerator::MeshGenerator*>& listObj, const CollisionSettings& collisionSettings)
+	{
+		std::vector<ColliderShape> shapes;
+		shapes.reserve(listObj.size());
+		for (MeshGenerator::MeshGenerator* obj : listObj)
+		{
+			ColliderShape shape{};
+			shape.type = obj->type;
+			shape.center = obj->meshCenter;
+			switch (obj->type)
+			{
+			default:
+				std::cerr << "ERROR: Application Force: Wrong Mesh Type" << std::endl;
+				continue;
+
+			case MeshGenerator::PrimitiveType::SPHERE:
+			{
+				auto* sphere_obj = dynamic_cast<MeshGenerator::ProceduralSphereMesh*>(obj);
+				if (!sphere_obj) continue;
+				shape.radius = sphere_obj->radius;
+				break;
+			}
+			case MeshGenerator::PrimitiveType::BOX:
+			{
+				auto* box_obj = dynamic_cast<MeshGenerator::ProceduralBoxMesh*>(obj);
+				if (!box_obj) continue;
+				shape.rotation = boxRotationMatrix(box_obj->rotationAxis);
+				shape.invRotation = glm::transpose(shape.rotation);
+				shape.halfSize = boxCollisionHalfSize(box_obj->size, collisionSettings);
+				break;
+			}
+			case MeshGenerator::PrimitiveType::DISK:
+			{
+				auto* disk_obj = dynamic_cast<MeshGenerator::ProceduralDiskMesh*>(obj);
+				if (!disk_obj) continue;
+				shape.axis = glm::normalize(disk_obj->rotationAxis);
+				shape.radiusWithGap2 = glm::pow(disk_obj->radius + collisionSettings.antiClippingGap, 2.0f);
+				break;
+			}
+			case MeshGenerator::PrimitiveType::CONE:
+			{
+				auto* cone_obj = dynamic_cast<MeshGenerator::ProceduralConeMesh*>(obj);
+				if (!cone_obj) continue;
+				shape.axis = glm::normalize(cone_obj->rotationAxis);
+				shape.height = cone_obj->height;
+				shape.tanAngle = cone_obj->radius / cone_obj->height;
+				break;
+			}
+			case MeshGenerator::PrimitiveType::CYLINDER:
+			{
+				auto* cylinder_obj = dynamic_cast<MeshGenerator::ProceduralCylinderMesh*>(obj);
+				if (!cylinder_obj) continue;
+				shape.axis = glm::normalize(cylinder_obj->rotationAxis);
+				shape.radius = cylinder_obj->radius;
+				shape.height = cylinder_obj->height * 0.5f;
+				shape.radiusWithGap2 = glm::pow(cylinder_obj->radius + collisionSettings.antiClippingGap, 2.0f);
+				break;
+			}
+			}
+			shapes.push_back(shape);
+		}
+		return shapes;
+	}
+
+	// Reponse d'un objet pre-calcule, selon son type (chemins non specialises par type d'objet, voir ColliderGroups pour le substep fusionne)
+	inline glm::vec3 colliderForce(const ColliderShape& shape, const glm::vec3& position, const glm::vec3& velocity, const CollisionSettings& collisionSettings)
+	{
+		switch (shape.type)
+		{
+		case MeshGenerator::PrimitiveType::SPHERE:
+			return sphereCollisionForce(position, shape.center, shape.radius, collisionSettings);
+		case MeshGenerator::PrimitiveType::BOX:
+			return boxCollisionForce(position, shape.center, shape.rotation, shape.invRotation, shape.halfSize, collisionSettings);
+		case MeshGenerator::PrimitiveType::DISK:
+			return diskCollisionForce(position, velocity, shape.center, shape.axis, shape.radiusWithGap2, collisionSettings);
+		case MeshGenerator::PrimitiveType::CONE:
+			return coneCollisionForce(position, velocity, shape.center, shape.axis, shape.height, shape.tanAngle, collisionSettings);
+		case MeshGenerator::PrimitiveType::CYLINDER:
+			return cylinderCollisionForce(position, velocity, shape.center, shape.radius, shape.height, shape.radiusWithGap2, shape.axis, collisionSettings);
+		}
+		return glm::vec3(0.0f);
+	}
+
+	// Raideur et amortissement de la reponse le long de la normale de contact (memes facteurs que les fonctions ci-dessus)
+	inline void colliderNormalCoefficients(const ColliderShape& shape, const CollisionSettings& collisionSettings, float& stiffness, float& damping)
+	{
+		switch (shape.type)
+		{
+		case MeshGenerator::PrimitiveType::CYLINDER:
+			stiffness = collisionSettings.stiffness / 1000.0f;
+			damping = collisionSettings.damping;
+			break;
+		case MeshGenerator::PrimitiveType::DISK:
+			stiffness = collisionSettings.stiffness / 10000.0f;
+			damping = collisionSettings.damping;
+			break;
+		case MeshGenerator::PrimitiveType::CONE:
+			stiffness = collisionSettings.stiffness;
+			damping = collisionSettings.damping;
+			break;
+		default:
+			stiffness = collisionSettings.stiffness;
+			damping = 0.0f;
+			break;
+		}
+	}
 
-			// Distance signée au plan du disque
-			float distToPlane = glm::dot(toPoint, diskNormal);
+	// Objets de la frame ranges par type (indice : MeshGenerator::PrimitiveType)
+	using ColliderGroups = std::array<std::vector<ColliderShape>, 5>;
 
-			// Projection pour test radial
-			glm::vec3 projected = pos - distToPlane * diskNormal;
-			float radialDist2 = glm::length2(projected - diskCenter);
+	// Reponse d'un type d'objet, choisie par surcharge sur la politique
+	inline glm::vec3 colliderForce(ForcePipeline::Sphere, const ColliderShape& shape, const glm::vec3& position, const glm::vec3&, const CollisionSettings& collisionSettings)
+	{
+		return sphereCollisionForce(position, shape.center, shape.radius, collisionSettings);
+	}
+	inline glm::vec3 colliderForce(ForcePipeline::Box, const ColliderShape& shape, const glm::vec3& position, const glm::vec3&, const CollisionSettings& collisionSettings)
+	{
+		return boxCollisionForce(position, shape.center, shape.rotation, shape.invRotation, shape.halfSize, collisionSettings);
+	}
+	inline glm::vec3 colliderForce(ForcePipeline::Disk, const ColliderShape& shape, const glm::vec3& position, const glm::vec3& velocity, const CollisionSettings& collisionSettings)
+	{
+		return diskCollisionForce(position, velocity, shape.center, shape.axis, shape.radiusWithGap2, collisionSettings);
+	}
+	inline glm::vec3 colliderForce(ForcePipeline::Cone, const ColliderShape& shape, const glm::vec3& position, const glm::vec3& velocity, const CollisionSettings& collisionSettings)
+	{
+		return coneCollisionForce(position, velocity, shape.center, shape.axis, shape.height, shape.tanAngle, collisionSettings);
+	}
+	inline glm::vec3 colliderForce(ForcePipeline::Cylinder, const ColliderShape& shape, const glm::vec3& position, const glm::vec3& velocity, const CollisionSettings& collisionSettings)
+	{
+		return cylinderCollisionForce(position, velocity, shape.center, shape.radius, shape.height, shape.radiusWithGap2, shape.axis, collisionSettings);
+	}
+
+	// Tableau de ColliderGroups d'une politique, -1 si ce n'est pas un objet
+	template <typename Policy>
+	constexpr int colliderGroup()
+	{
+		if constexpr (std::is_same_v<Policy, ForcePipeline::Sphere>)   return static_cast<int>(MeshGenerator::PrimitiveType::SPHERE);
+		if constexpr (std::is_same_v<Policy, ForcePipeline::Box>)      return static_cast<int>(MeshGenerator::PrimitiveType::BOX);
+		if constexpr (std::is_same_v<Policy, ForcePipeline::Disk>)     return static_cast<int>(MeshGenerator::PrimitiveType::DISK);
+		if constexpr (std::is_same_v<Policy, ForcePipeline::Cone>)     return static_cast<int>(MeshGenerator::PrimitiveType::CONE);
+		if constexpr (std::is_same_v<Policy, ForcePipeline::Cylinder>) return static_cast<int>(MeshGenerator::PrimitiveType::CYLINDER);
+		return -1;
+	}
+
+	// Objets de la frame ranges par type, une fois par frame (vide si les collisions sont desactivees)
+	ColliderGroups groupColliderShapes(const std::vector<ColliderShape>& shapes)
+	{
+		ColliderGroups colliders;
+		for (const ColliderShape& collider : shapes)
+			colliders[static_cast<int>(collider.type)].push_back(collider);
+		return colliders;
+	}
 
-			if (distToPlane < 0.0f && radialDist2 <= radiusWithGap2) {
-				float penetration = -distToPlane + collisionSettings.antiClippingGap;
+	ColliderGroups buildColliderGroups(const std::vector<MeshGenerator::MeshGenerator*>& listObj, const CollisionSettings& collisionSettings)
+	{
+		if (!collisionSettings.isEnabled)
+			return ColliderGroups{};
+		return groupColliderShapes(buildColliderShapes(listObj, collisionSettings));
+	}
 
-				// Force de réaction (type ressort)
-				glm::vec3 reaction_force = diskNormal * penetration * collisionSettings.stiffness/10000;
-				tissu.accelerations[i] += reaction_force;
+	// Reponses des objets en un point, un tableau par type d'objet de la politique, sans switch
+	template <typename... Policies>
+	inline void addColliderForces(ForcePipeline::Substep<Policies...>, const ColliderGroups& colliders, const glm::vec3& position, const glm::vec3& velocity,
+		const CollisionSettings& collisionSettings, glm::vec3& acceleration)
+	{
+		auto addGroup = [&](auto policy) {
+			constexpr int group = colliderGroup<decltype(policy)>();
+			if constexpr (group >= 0) {
+				for (const ColliderShape& collider : colliders[group])
+					acceleration += colliderForce(policy, collider, position, velocity, collisionSettings);
+			}
+		};
+		(addGroup(Policies{}), ...);
+	}
 
-				// Force de freinage (amortissement vertical extrême)
-				glm::vec3 vertical_velocity = glm::dot(velocity, diskNormal) * diskNormal;
-				glm::vec3 damping_force = -collisionSettings.damping * vertical_velocity;
-				tissu.accelerations[i] += damping_force;
+	// Reponses d'un type d'objet sur tout le tissu, un parcours des points par objet
+	template <typename Policy>
+	void applyColliderGroup(Policy policy, Tissu::TissuSoA& tissu, const ColliderGroups& colliders, const CollisionSettings& collisionSettings)
+	{
+		constexpr int group = colliderGroup<Policy>();
+		if constexpr (group >= 0) {
+			for (const ColliderShape& collider : colliders[group]) {
+				#pragma omp parallel for
+				for (int i = 0; i < static_cast<int>(tissu.positions.size()); i++)
+					tissu.accelerations[i] += colliderForce(policy, collider, tissu.positions[i], tissu.vitesse(i), collisionSettings);
 			}
 		}
 	}
-	
+
+	// Instanciation (force_pipeline.h) pour les reglages et les objets de la frame : indice des tables de substeps
+	inline int selectSubstepPipeline(const PhysicsSettings& physicsSettings, const ColliderGroups& colliders)
+	{
+		int termMask = 0;
+		if (physicsSettings.gravitySettings.isEnabled) termMask |= ForcePipeline::TERM_GRAVITY;
+		if (physicsSettings.tensionSettings.isEnabled) termMask |= ForcePipeline::TERM_TENSION;
+		if (physicsSettings.windSettings.isEnabled)    termMask |= ForcePipeline::TERM_WIND;
+		if (physicsSettings.dragSettings.isEnabled)    termMask |= ForcePipeline::TERM_DRAG;
+
+		ForcePipeline::ColliderSet set = ForcePipeline::ColliderSet::NONE;
+		for (int type = 0; type < static_cast<int>(colliders.size()); type++) {
+			if (colliders[type].empty())
+				continue;
+			const bool isSphereOrBox = type == static_cast<int>(MeshGenerator::PrimitiveType::SPHERE) || type == static_cast<int>(MeshGenerator::PrimitiveType::BOX);
+			set = (isSphereOrBox && set != ForcePipeline::ColliderSet::ALL) ? ForcePipeline::ColliderSet::SPHERE_BOX : ForcePipeline::ColliderSet::ALL;
+		}
+		return ForcePipeline::tableIndex(termMask, set);
+	}
 
 	// ------------------------------------------------------------------------------------------------
 	// Grab Force
 	void calculForceGrab(Tissu::TissuSoA& tissu, const GrabSettings& grabSettings)
 	{
-		if (Grabbing::isGrabbing && tissu.grabbedIndex != -1) {
-			glm::vec3 targetPos = Grabbing::rayOrigin + Grabbing::rayDirection * tissu.grabDepth;
+		if (tissu.grabbedIndex != -1) {
+			glm::vec3 targetPos = tissu.grabTarget;
 			glm::vec3 vel = tissu.positions[tissu.grabbedIndex] - tissu.positionsOld[tissu.grabbedIndex];
 
 			glm::vec3 delta = targetPos - tissu.positions[tissu.grabbedIndex];
@@ -384,195 +1024,1591 @@ namespace Physics
 
 	// ------------------------------------------------------------------------------------------------
 	// Self Collision
-	// Hash fonction pour glm::ivec3
-	struct IVec3Hash {
-		size_t operator()(const glm::ivec3& v) const {
-			return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1) ^ (std::hash<int>()(v.z) << 2);
-		}
-	};
-
-	void handleSelfCollisions(std::vector<glm::vec3>& positions,
-		float minDistance,
-		float cellSize) {
-
-		std::unordered_map<glm::ivec3, std::vector<size_t>, IVec3Hash> spatialMap;
-		float minDistance2 = minDistance * minDistance;
+	// Voisinage par grille uniforme hachee (spatial_hash.h) construite par tri par comptage, gardee sous forme de listes
+	// de voisins persistantes : la grille et les listes (rayon minDistance + skinDistance) ne sont reconstruites que
+	// lorsqu'un point a bouge de plus de skinDistance / 2 depuis la derniere construction. Les autres substeps
+	// ne testent que les paires des listes.
+	// cellSize doit etre au moins le rayon des listes : deux points voisins sont alors dans des cellules voisines (3x3x3).
+	// Resolution de type Jacobi en deux phases :
+	//   1) chaque point lit les positions (non modifiees) de ses voisins et calcule la moyenne de ses corrections ;
+	//   2) chaque point applique sa propre correction.
+	// Un thread n'ecrit que dans les cases de ses points : le resultat ne depend ni du nombre de threads ni de l'ordre.
+	// La correction est appliquee aussi a positionsOld : elle deplace le point sans lui donner de vitesse.
+	// Les deux phases utilisent des "omp for" orphelins : elles s'appellent dans une region parallele deja ouverte
+	// (substep fusionne) ou via handleSelfCollisions qui ouvre la sienne.
+
+	// Paire exclue : les cases (x * resolutionY + y) des deux points sont a au plus rings anneaux l'une de l'autre
+	// (distance de Chebyshev dans la grille du tissu). Ces voisins sont deja tenus par les ressorts.
+	inline bool isWithinRings(uint32_t cellA, uint32_t cellB, uint32_t resolutionY, int rings)
+	{
+		const int dx = static_cast<int>(cellA / resolutionY) - static_cast<int>(cellB / resolutionY);
+		const int dy = static_cast<int>(cellA % resolutionY) - static_cast<int>(cellB % resolutionY);
+		return std::abs(dx) <= rings && std::abs(dy) <= rings;
+	}
 
-		// Étape 1 : assigner chaque point à une cellule
+	// A appeler par tous les threads d'une region parallele (boucles "omp for" orphelines de spatial_hash.h), ou hors region
+	void updateSelfCollisionNeighbors(Tissu::TissuSoA& tissu, const SelfCollisionSettings& settings)
+	{
+		SpatialHash::NeighborList& neighborList = tissu.selfCollisionNeighbors;
+		const size_t count = tissu.positions.size();
+		const float skin = std::max(settings.skinDistance, 0.0f);
+		const float radius = settings.minDistance + skin;
+		#pragma omp single
+		tissu.selfCollisionCorrections.resize(count);
+
+		// Meme decision pour tous les threads : la liste n'est modifiee qu'apres la barriere ci-dessous
+		const bool isReusable = !neighborList.isEmpty() && neighborList.radius == radius && neighborList.offsets.size() == count + 1 && skin > 0.0f;
+		if (isReusable && !neighborList.hasMovedBeyond(tissu.positions, 0.5f * skin))
+			return;
+		#pragma omp barrier
+
+		const int excludedRings = settings.excludedRings;
+		const uint32_t resolutionY = static_cast<uint32_t>(tissu.tissuSettings.resolutionY);
+		const uint32_t* indexToGrid = tissu.indexToGrid.empty() ? nullptr : tissu.indexToGrid.data();
+		tissu.selfCollisionGrid.build(tissu.positions, std::max(settings.cellSize, radius));
+		neighborList.build(tissu.selfCollisionGrid, tissu.positions, radius, [&](uint32_t i, uint32_t j) {
+			if (excludedRings <= 0)
+				return false;
+			return isWithinRings(indexToGrid ? indexToGrid[i] : i, indexToGrid ? indexToGrid[j] : j, resolutionY, excludedRings);
+		});
+	}
 
-		{
-			std::unordered_map<glm::ivec3, std::vector<size_t>, IVec3Hash> localMap;
-			for (size_t i = 0; i < positions.size(); ++i) {
-				glm::ivec3 cell = glm::floor(positions[i] / cellSize);
-				#pragma omp critical
-				spatialMap[cell].push_back(i);
-			}
-		}
-
-		// Étape 2 : tester collisions entre cellules voisines
-		for (int c = 0; c < static_cast<int>(spatialMap.size()); ++c) {
-			auto it = std::next(spatialMap.begin(), c);
-			const glm::ivec3& cell = it->first;
-			const std::vector<size_t>& indices = it->second;
-
-			for (int dx = -1; dx <= 1; ++dx) {
-				for (int dy = -1; dy <= 1; ++dy) {
-					for (int dz = -1; dz <= 1; ++dz) {
-						glm::ivec3 neighborCell = cell + glm::ivec3(dx, dy, dz);
-						auto neighborIt = spatialMap.find(neighborCell);
-						if (neighborIt == spatialMap.end()) continue;
-
-						const auto& neighbors = neighborIt->second;
-
-						for (size_t i = 0; i < indices.size(); ++i) {
-							size_t idxA = indices[i];
-							for (size_t j = 0; j < neighbors.size(); ++j) {
-								size_t idxB = neighbors[j];
-								if (idxA >= idxB) continue; // éviter doublons
-
-								glm::vec3 delta = positions[idxA] - positions[idxB];
-								float dist2 = glm::dot(delta, delta);
-								if (dist2 < minDistance2 && dist2 > glm::epsilon<float>()) {
-									glm::vec3 dir = glm::normalize(delta);
-									float penetration = minDistance - std::sqrt(dist2);
-									glm::vec3 correction = 0.5f * penetration * dir;
-
-
-									{
-										positions[idxA] += correction;
-										positions[idxB] -= correction;
-									}
-								}
-							}
-						}
-					}
+	// Phase 1 : selfCollisionCorrections[i] = moyenne des penetration * invMass_i / (invMass_i + invMass_j) * direction
+	// sur les voisins j de i trop proches. Un point fixe (invMass nulle) recoit une part nulle, son voisin toute la correction
+	void gatherSelfCollisionCorrections(Tissu::TissuSoA& tissu, const SelfCollisionSettings& settings)
+	{
+		const SpatialHash::NeighborList& neighborList = tissu.selfCollisionNeighbors;
+		const float minDistance = settings.minDistance;
+		const float minDistance2 = minDistance * minDistance;
+		const uint32_t* offsets = neighborList.offsets.data();
+		const uint32_t* neighbors = neighborList.neighbors.data();
+		const glm::vec3* positions = tissu.positions.data();
+		const float* invMasses = tissu.invMasses.data();
+		glm::vec3* corrections = tissu.selfCollisionCorrections.data();
+		const int count = static_cast<int>(tissu.positions.size());
+
+		// Les contacts sont regroupes dans les plis : repartition dynamique
+		#pragma omp for schedule(dynamic, 256)
+		for (int idxA = 0; idxA < count; ++idxA) {
+			const glm::vec3 positionA = positions[idxA];
+			const float invMassA = invMasses[idxA];
+			glm::vec3 correctionSum(0.0f);
+			int contactCount = 0;
+
+			for (uint32_t k = offsets[idxA]; k < offsets[idxA + 1]; ++k) {
+				const uint32_t idxB = neighbors[k];
+				const float invMassSum = invMassA + invMasses[idxB];
+				if (invMassSum <= 0.0f)
+					continue;
+				glm::vec3 delta = positionA - positions[idxB];
+				float dist2 = glm::dot(delta, delta);
+				if (dist2 < minDistance2 && dist2 > glm::epsilon<float>()) {
+					float dist = std::sqrt(dist2);
+					float penetration = minDistance - dist;
+					correctionSum += (penetration * invMassA / (invMassSum * dist)) * delta;
+					contactCount++;
 				}
 			}
+			corrections[idxA] = contactCount > 0 ? correctionSum / static_cast<float>(contactCount) : glm::vec3(0.0f);
 		}
 	}
 
-	// ------------------------------------------------------------------------------------------------
-	// ------------------------------------------------------------------------------------------------
-	// Main Calculation
-	void applicationForces(Tissu::TissuSoA& LeTissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings)
+	// Phase 2 : les points fixes ne bougent pas (ni positions ni positionsOld)
+	void applySelfCollisionCorrections(Tissu::TissuSoA& tissu)
 	{
-		// -------------------------------------------------------------------------------------
-		// Acceleraction remise à zéro à chaque frame
-		LeTissu.resetAcceleration();
+		const glm::vec3* corrections = tissu.selfCollisionCorrections.data();
+		const float* invMasses = tissu.invMasses.data();
+		const int count = static_cast<int>(tissu.positions.size());
+		#pragma omp for schedule(static)
+		for (int i = 0; i < count; ++i) {
+			if (invMasses[i] == 0.0f)
+				continue;
+			tissu.positions[i] += corrections[i];
+			tissu.positionsOld[i] += corrections[i];
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Self Collision par triangles (modele TRIANGLE)
+	// Point-triangle et arete-arete avec detection continue (continuous_collision.h) sur le deplacement du dernier pas,
+	// positionsOld -> positions. Candidats : paires de triangles proches trouvees dans le BVH des triangles (triangle_bvh.h),
+	// construit une fois puis recalcule a chaque appel. Les primitives qui partagent un point ne sont pas testees.
+	// Chaque contact donne une correction de position (contrainte d'epaisseur minDistance, ponderee par les masses
+	// inverses) ; les corrections d'un point sont moyennees puis appliquees aux seules positions : la vitesse
+	// d'approche est annulee. Les contacts sont tries avant d'etre cumules : resultat independant des threads.
+	// A appeler par tous les threads d'une region parallele (boucles "omp for" orphelines), comme les deux phases du modele VERTEX.
+	void resolveTriangleSelfCollisions(Tissu::TissuSoA& tissu, const SelfCollisionSettings& settings)
+	{
+		TriangleBvh::MeshBvh& bvh = tissu.selfCollisionBvh;
+		std::vector<ContinuousCollision::Contact>& contacts = tissu.selfCollisionContacts;
+		const float thickness = settings.minDistance;
+		const int count = static_cast<int>(tissu.positions.size());
+
+		#pragma omp single
+		{
+			if (!bvh.matches(tissu.EBOBuffer))
+				bvh.build(tissu.EBOBuffer, tissu.positions);
+			contacts.clear();
+			tissu.selfCollisionCorrections.assign(count, glm::vec3(0.0f));
+			tissu.selfCollisionContactCounts.assign(count, 0);
+		}
+		bvh.refit(tissu.positionsOld, tissu.positions, 0.5f * thickness);
+
+		const std::vector<glm::vec3>& start = tissu.positionsOld;
+		const std::vector<glm::vec3>& end = tissu.positions;
+		const uint32_t* triangles = bvh.triangles.data();
+		const uint8_t* ownership = bvh.triangleOwnership.data();
+		std::vector<ContinuousCollision::Contact> localContacts;
+
+		// Boite du deplacement du point ou de l'arete (a, b), elargie comme celles des triangles : filtre avant les tests exacts
+		auto sweptBox = [&](uint32_t a, uint32_t b) {
+			TriangleBvh::Aabb box;
+			box.min = glm::min(glm::min(start[a], end[a]), glm::min(start[b], end[b])) - glm::vec3(0.5f * thickness);
+			box.max = glm::max(glm::max(start[a], end[a]), glm::max(start[b], end[b])) + glm::vec3(0.5f * thickness);
+			return box;
+		};
+
+		// Points de t contre le triangle u
+		auto testVertices = [&](uint32_t t, uint32_t u) {
+			const uint32_t a = triangles[3 * u], b = triangles[3 * u + 1], c = triangles[3 * u + 2];
+			for (int k = 0; k < 3; k++) {
+				if (!(ownership[t] & (1 << k)))
+					continue;
+				const uint32_t i = triangles[3 * t + k];
+				if (i == a || i == b || i == c || !sweptBox(i, i).overlaps(bvh.triangleBoxes[u]))
+					continue;
+				ContinuousCollision::Contact contact;
+				if (ContinuousCollision::vertexTriangle(start[i], start[a], start[b], start[c], end[i], end[a], end[b], end[c], thickness, contact)) {
+					contact.type = ContinuousCollision::VERTEX_TRIANGLE;
+					contact.primitiveA = i;
+					contact.primitiveB = u;
+					contact.vertices = { i, a, b, c };
+					localContacts.push_back(contact);
+				}
+			}
+		};
+
+		// Aretes de t contre aretes de u
+		auto testEdges = [&](uint32_t t, uint32_t u) {
+			for (int k = 0; k < 3; k++) {
+				if (!(ownership[t] & (1 << (3 + k))))
+					continue;
+				for (int l = 0; l < 3; l++) {
+					if (!(ownership[u] & (1 << (3 + l))))
+						continue;
+					uint32_t e = bvh.triangleEdges[3 * t + k], f = bvh.triangleEdges[3 * u + l];
+					if (e > f) std::swap(e, f);
+					const glm::uvec2 edgeP = bvh.edges[e], edgeQ = bvh.edges[f];
+					if (edgeQ.x == edgeP.x || edgeQ.x == edgeP.y || edgeQ.y == edgeP.x || edgeQ.y == edgeP.y)
+						continue;
+					if (!sweptBox(edgeP.x, edgeP.y).overlaps(sweptBox(edgeQ.x, edgeQ.y)))
+						continue;
+					ContinuousCollision::Contact contact;
+					if (ContinuousCollision::edgeEdge(start[edgeP.x], start[edgeP.y], start[edgeQ.x], start[edgeQ.y],
+						end[edgeP.x], end[edgeP.y], end[edgeQ.x], end[edgeQ.y], thickness, contact)) {
+						contact.type = ContinuousCollision::EDGE_EDGE;
+						contact.primitiveA = e;
+						contact.primitiveB = f;
+						contact.vertices = { edgeP.x, edgeP.y, edgeQ.x, edgeQ.y };
+						localContacts.push_back(contact);
+					}
+				}
+			}
+		};
+
+		// Chaque paire de triangles proches une fois, chaque primitive testee par le triangle qui la possede
+		const int jobCount = static_cast<int>(bvh.selfCollisionJobs.size());
+		#pragma omp for schedule(dynamic, 1) nowait
+		for (int job = 0; job < jobCount; job++) {
+			bvh.runSelfCollisionJob(bvh.selfCollisionJobs[job], [&](uint32_t t, uint32_t u) {
+				testVertices(t, u);
+				testVertices(u, t);
+				testEdges(t, u);
+			});
+		}
+
+		#pragma omp critical
+		contacts.insert(contacts.end(), localContacts.begin(), localContacts.end());
+		#pragma omp barrier
+
+		// Cumul dans l'ordre des contacts
+		#pragma omp single
+		{
+			std::sort(contacts.begin(), contacts.end());
+
+			for (const ContinuousCollision::Contact& contact : contacts) {
+				float separation = -thickness;
+				float weightSum = 0.0f;
+				for (int k = 0; k < 4; k++) {
+					separation += contact.coefficients[k] * glm::dot(contact.normal, end[contact.vertices[k]]);
+					weightSum += contact.coefficients[k] * contact.coefficients[k] * tissu.invMasses[contact.vertices[k]];
+				}
+				if (separation >= 0.0f || weightSum <= 0.0f)
+					continue;
+				const float lambda = -separation / weightSum;
+				for (int k = 0; k < 4; k++) {
+					const uint32_t vertex = contact.vertices[k];
+					const float weight = contact.coefficients[k] * tissu.invMasses[vertex];
+					if (weight == 0.0f)
+						continue;
+					tissu.selfCollisionCorrections[vertex] += (lambda * weight) * contact.normal;
+					tissu.selfCollisionContactCounts[vertex]++;
+				}
+			}
+		}
+
+		#pragma omp for schedule(static)
+		for (int i = 0; i < count; i++) {
+			const int contactCount = tissu.selfCollisionContactCounts[i];
+			if (contactCount > 0)
+				tissu.positions[i] += tissu.selfCollisionCorrections[i] / static_cast<float>(contactCount);
+		}
+	}
+
+	void handleSelfCollisions(Tissu::TissuSoA& tissu, const SelfCollisionSettings& settings)
+	{
+		if (settings.model == SelfCollisionModel::TRIANGLE) {
+			#pragma omp parallel
+			resolveTriangleSelfCollisions(tissu, settings);
+			return;
+		}
+
+		#pragma omp parallel
+		{
+			updateSelfCollisionNeighbors(tissu, settings);
+			gatherSelfCollisionCorrections(tissu, settings);
+			applySelfCollisionCorrections(tissu);
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Pas de Verlet d'un point, commun a tous les chemins Verlet (float ou double)
+	// x(t + 1) = x(t) + displacement + F(t) / m * dt²      displacement : [x(t) - x(t - 1)], apres le frottement de l'air
+	// Un point fixe a invMass = 0 et un deplacement nul (voir setFixed) : il reste en place sans masque.
+	// Sol sans branche, comme le noyau SIMD : le pas est borne au sol (un point deja dessous n'est pas remonte),
+	// puis un point libre sur le sol s'y pose et devient fixe (un octet et un float par point : pas de conflit entre threads)
+	template <typename Scalar>
+	inline glm::vec<3, Scalar> verletStep(Tissu::TissuSoA& tissu, size_t i, const glm::vec<3, Scalar>& position, const glm::vec<3, Scalar>& displacement,
+		const glm::vec<3, Scalar>& force, Scalar dt2, Scalar floorHeight)
+	{
+		const float invMass = tissu.invMasses[i];
+		glm::vec<3, Scalar> moved = position + displacement + force * (dt2 * static_cast<Scalar>(invMass));
+		moved.z = std::max(moved.z, std::min(position.z, floorHeight));
+		const bool lands = invMass > 0.0f && position.z <= floorHeight;
+		tissu.markLanded(i, lands);
+		return lands ? position : moved;
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation
+	// Forces du pas courant dans accelerations (partagees par Verlet et par les integrateurs implicite, XPBD et PD)
+	// Specialise a la compilation comme le substep fusionne (force_pipeline.h) : Substep<Gravity, Tension, Wind, Drag, Sphere, Box...>
+	// ne fait que les passes de ses termes, les objets sont parcourus par type sans switch ni dynamic_cast
+	template <typename... Policies>
+	void accumulateForces(ForcePipeline::Substep<Policies...>, Tissu::TissuSoA& LeTissu, const ColliderGroups& colliders, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		using Pipeline = ForcePipeline::Substep<Policies...>;
+
+		// -------------------------------------------------------------------------------------
+		// Acceleraction remise à zéro à chaque frame
+		LeTissu.resetAcceleration();
 
 		// -------------------------------------------------------------------------------------
 		// Self Collision
 		if (physicsSettings.selfCollisionSettings.isEnabled)
-			handleSelfCollisions(LeTissu.positions, physicsSettings.selfCollisionSettings.minDistance, physicsSettings.selfCollisionSettings.cellSize);
+			handleSelfCollisions(LeTissu, physicsSettings.selfCollisionSettings);
 		// -------------------------------------------------------------------------------------
 		// Gravité
-		if (physicsSettings.gravitySettings.isEnabled)
+		if constexpr (Pipeline::template has<ForcePipeline::Gravity>)
 			calculForceGravite(LeTissu, physicsSettings.gravitySettings);
 		// Tension
-		if (physicsSettings.tensionSettings.isEnabled)
+		if constexpr (Pipeline::template has<ForcePipeline::Tension>)
 			calculForceTension(LeTissu, physicsSettings.tensionSettings);
 		// Wind
-		if (physicsSettings.windSettings.isEnabled)
-			calculForceWind(LeTissu, physicsSettings.windSettings);
+		if constexpr (Pipeline::template has<ForcePipeline::Wind>)
+			applyWind(LeTissu, physicsSettings.windSettings, physicsSettings.temporalSettings, simulationTime);
 		// Collsion
-		if (physicsSettings.collisionSettings.isEnabled) {
-			for (MeshGenerator::MeshGenerator* obj : listObj)
-			{
-				switch (obj->type)
-				{
-				default:
-					std::cerr << "ERROR: Application Force: Wrong Mesh Type" << std::endl;
-					break;
-
-				case MeshGenerator::PrimitiveType::SPHERE:
-				{
-					auto* sphere_obj = dynamic_cast<MeshGenerator::ProceduralSphereMesh*>(obj);
-					if (sphere_obj)
-					{
-						applySphereCollisionResponse(LeTissu, sphere_obj->meshCenter, sphere_obj->radius, physicsSettings.collisionSettings);
+		(applyColliderGroup(Policies{}, LeTissu, colliders, physicsSettings.collisionSettings), ...);
+
+		// Grab
+		if (physicsSettings.grabSettings.isEnabled)
+			calculForceGrab(LeTissu, physicsSettings.grabSettings);
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Mise en sommeil par tuiles (sleep_tiles.h)
+	// Chemin Verlet classique seulement, sans auto-collision (elle deplace des points sans passer par les tuiles) ni vent par triangle
+	inline bool canUseSleeping(const PhysicsSettings& physicsSettings)
+	{
+		return physicsSettings.sleepSettings.isEnabled
+			&& physicsSettings.temporalSettings.integrator == Integrator::VERLET
+			&& physicsSettings.precisionSettings.mode == Precision::FLOAT
+			&& (!physicsSettings.windSettings.isEnabled || physicsSettings.windSettings.model == WindModel::VERTEX)
+			&& !physicsSettings.selfCollisionSettings.isEnabled;
+	}
+
+	// Pas de Verlet limite aux tuiles eveillees : une tuile calcule ses ressorts (accumulateTileStencil) puis les autres forces
+	// et l'integration de ses points, sans ecrire hors de la tuile. Les points endormis ne sont lus que comme extremites de ressorts.
+	// Repos : energie cinetique 0.5 * (d / h)^2 < energyThreshold (h = dt / sqrt(substeps)), ou d est le deplacement par substep
+	// qu'aurait le point au bout de calmSubsteps substeps sous sa force nette actuelle : un tissu lache immobile ne s'endort pas.
+	// Tout le tissu se reveille si gravite + vent changent (oscillation du vent, console) ; le point attrape reveille sa tuile et ses voisines.
+	void applicationForcesAwakeTiles(Tissu::TissuSoA& tissu, const ColliderGroups& colliders, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		constexpr float fieldWakeFraction = 0.01f; // Variation du champ exterieur, en fraction de gravite + vent, qui reveille tout le tissu
+		const GravitySettings& gravitySettings = physicsSettings.gravitySettings;
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		const WindSettings& windSettings = physicsSettings.windSettings;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+		const GrabSettings& grabSettings = physicsSettings.grabSettings;
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		const SleepSettings& sleepSettings = physicsSettings.sleepSettings;
+
+		const int resX = static_cast<int>(tissu.tissuSettings.resolutionX);
+		const int resY = static_cast<int>(tissu.tissuSettings.resolutionY);
+		SleepTiles::TileGrid& tiles = tissu.sleepTiles;
+		const int tileSize = std::max(sleepSettings.tileSize, 2);
+		if (!tiles.matches(resX, resY, tileSize))
+			tiles.resize(resX, resY, tileSize);
+
+		// -------------------------------------------------------------------------------------
+		// Champ exterieur
+		glm::vec3 gravity = gravitySettings.directionVector * gravitySettings.amplitude;
+
+		glm::vec3 windDirection(0.0f);
+		glm::vec3 windBase(0.0f);
+		float windVariation = 1.0f;
+		if (windSettings.isEnabled) {
+			windDirection = glm::normalize(windSettings.directionVector);
+			windBase = windDirection * windSettings.amplitude;
+			windVariation = windOscillation(windSettings, simulationTime);
+		}
+
+		glm::vec3 externalField(0.0f);
+		if (gravitySettings.isEnabled)
+			externalField += gravity;
+		if (windSettings.isEnabled)
+			externalField += windBase * windVariation;
+		const float fieldTolerance = fieldWakeFraction * (gravitySettings.amplitude + windSettings.amplitude);
+		if (tiles.isWakeRequested || !tiles.hasExternalField || glm::length(externalField - tiles.externalField) > fieldTolerance) {
+			tiles.isWakeRequested = false;
+			tiles.externalField = externalField;
+			tiles.hasExternalField = true;
+			tiles.wakeAll();
+		}
+
+		const int grabbedIndex = grabSettings.isEnabled ? tissu.grabbedIndex : -1;
+		if (grabbedIndex != -1)
+			tiles.wakeAround(tissu.gridX(grabbedIndex), tissu.gridY(grabbedIndex));
+
+		// -------------------------------------------------------------------------------------
+		TensionSettings shearSettings = tensionSettings;
+		shearSettings.force = tensionSettings.shear.force;
+		TensionSettings bendingSettings = tensionSettings;
+		bendingSettings.force = tensionSettings.bending.force;
+
+		const float dt2 = (temporalSettings.dt * temporalSettings.dt) / temporalSettings.substeps;
+		const float substepDuration = temporalSettings.dt / std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, substepDuration);
+		const float motionThreshold2 = 2.0f * sleepSettings.energyThreshold * substepDuration * substepDuration;
+		const float calmWindow = static_cast<float>(sleepSettings.calmSubsteps);
+		const float floorHeight = tissu.tissuSettings.floorHeight;
+		const int awakeCount = static_cast<int>(tiles.awakeTiles.size());
+
+		#pragma omp parallel
+		{
+			std::vector<glm::vec3> tileForces(static_cast<size_t>(tiles.tileSize) * tiles.tileSize);
+
+			#pragma omp for schedule(dynamic)
+			for (int k = 0; k < awakeCount; k++) {
+				const int t = tiles.awakeTiles[k];
+				int xBegin, xEnd, yBegin, yEnd;
+				tiles.bounds(t, xBegin, xEnd, yBegin, yEnd);
+
+				// Tension de toute la tuile
+				std::fill(tileForces.begin(), tileForces.end(), glm::vec3(0.0f));
+				if (tensionSettings.isEnabled) {
+					accumulateTileStencil(GridStencil::Structural{}, tissu, tensionSettings, xBegin, xEnd, yBegin, yEnd, tiles.tileSize, tileForces.data());
+					if (tensionSettings.shear.isEnabled)
+						accumulateTileStencil(GridStencil::Shear{}, tissu, shearSettings, xBegin, xEnd, yBegin, yEnd, tiles.tileSize, tileForces.data());
+					if (tensionSettings.bending.isEnabled)
+						accumulateTileStencil(GridStencil::Bending{}, tissu, bendingSettings, xBegin, xEnd, yBegin, yEnd, tiles.tileSize, tileForces.data());
+				}
+
+				float tileMotion = 0.0f;
+				for (int x = xBegin; x < xEnd; x++) {
+					for (int y = yBegin; y < yEnd; y++) {
+						const size_t i = tissu.gridIndex(x, y);
+						const glm::vec3 position = tissu.positions[i];
+						const glm::vec3 vitesse = position - tissu.positionsOld[i];
+						const float invMass = tissu.invMasses[i];
+						glm::vec3 acceleration(0.0f); // Force, multipliee par invMass dans Verlet
+
+						// Gravité
+						if (gravitySettings.isEnabled && position.z >= floorHeight && (tissu.vertexFlags[i] & Tissu::VERTEX_GRAVITY))
+							acceleration += gravity * tissu.masses[i];
+
+						// Tension
+						acceleration += tileForces[(x - xBegin) * tiles.tileSize + (y - yBegin)];
+
+						// Wind
+						if (windSettings.isEnabled) {
+							float surfaceFactor = glm::clamp(glm::dot(tissu.normals[i], windDirection), 0.0f, 1.0f);
+							acceleration += windBase * surfaceFactor * windVariation;
+						}
+
+						// Collision
+						addColliderForces(ForcePipeline::AllColliders{}, colliders, position, vitesse, collisionSettings, acceleration);
+
+						// Grab
+						if (static_cast<int>(i) == grabbedIndex)
+							acceleration += (tissu.grabTarget - position) * grabSettings.force - grabSettings.damping * vitesse;
+
+						// Verlet
+						tissu.positionsNew[i] = verletStep(tissu, i, position, drag.apply(vitesse, invMass), acceleration, dt2, floorHeight);
+						// Deplacement par substep qu'aurait le point a la fin de la fenetre de repos si sa force nette restait la meme (0 sur un point fixe)
+						const float restMotion = glm::length(tissu.positionsNew[i] - position) + calmWindow * glm::length(acceleration) * (invMass * dt2);
+						tileMotion = std::max(tileMotion, restMotion * restMotion);
 					}
-					break;
 				}
+				tiles.motion[t] = tileMotion;
+			}
+		}
 
-				case MeshGenerator::PrimitiveType::BOX:
-				{
-					auto* box_obj = dynamic_cast<MeshGenerator::ProceduralBoxMesh*>(obj);
-					if (box_obj)
-					{
-						applyBoxCollisionResponse_SDF(LeTissu, box_obj->meshCenter, box_obj->size, box_obj->rotationAxis, physicsSettings.collisionSettings);
+		tissu.updateVertexPosition();
+
+		// Endormissement : vitesse nulle et trois buffers egaux, la rotation ne deplace plus ces points
+		if (tiles.update(motionThreshold2, sleepSettings.calmSubsteps) > 0) {
+			for (int t : tiles.fallingAsleep) {
+				int xBegin, xEnd, yBegin, yEnd;
+				tiles.bounds(t, xBegin, xEnd, yBegin, yEnd);
+				for (int x = xBegin; x < xEnd; x++) {
+					for (int y = yBegin; y < yEnd; y++) {
+						const size_t i = tissu.gridIndex(x, y);
+						tissu.positionsOld[i] = tissu.positions[i];
+						tissu.positionsNew[i] = tissu.positions[i];
 					}
-					break;
 				}
+			}
+		}
+	}
+
+	// Pas de Verlet classique, specialise comme accumulateForces
+	template <typename... Policies>
+	void applicationForces(ForcePipeline::Substep<Policies...> pipeline, Tissu::TissuSoA& LeTissu, const ColliderGroups& colliders, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		accumulateForces(pipeline, LeTissu, colliders, physicsSettings, simulationTime);
+
+		// -------------------------------------------------------------------------------------
+		//Application de l'intégration de Verlet (+pression/+réaliste)
+		//x(t + 1) = x(t) + [x(t) - x(t - 1)] + F(t) / m * dt²               [x(t) - x(t - 1)] c'est la vitesse
+		// Le frottement de l'air reduit [x(t) - x(t - 1)] dans la meme boucle
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, substepDuration(physicsSettings.temporalSettings));
+		const float dt2 = (physicsSettings.temporalSettings.dt * physicsSettings.temporalSettings.dt) / physicsSettings.temporalSettings.substeps;
+		const float floorHeight = LeTissu.tissuSettings.floorHeight;
+		#pragma omp parallel for
+		for (int i = 0; i < static_cast<int>(LeTissu.accelerations.size()); i++) {
+			glm::vec3 displacement = LeTissu.vitesse(i);
+			if constexpr (ForcePipeline::Substep<Policies...>::template has<ForcePipeline::Drag>)
+				displacement = drag.damp(displacement, LeTissu.invMasses[i]);
+			LeTissu.positionsNew[i] = verletStep(LeTissu, i, LeTissu.positions[i], displacement, LeTissu.accelerations[i], dt2, floorHeight);
+		}
 
-				case MeshGenerator::PrimitiveType::DISK:
-				{
-					auto* disk_obj = dynamic_cast<MeshGenerator::ProceduralDiskMesh*>(obj);
-					if (disk_obj)
-					{
-						applyDiskCollisionResponse(LeTissu, disk_obj->meshCenter, disk_obj->radius, disk_obj->rotationAxis, physicsSettings.collisionSettings);
+		// -------------------------------------------------------------------------------------
+		// Implementation Double Buffering pour limiter les déformations artificielles causées par le traitement séquentiel
+		LeTissu.updateVertexPosition();  // NewPos -> Pos -> OldPos -> NewPos, la vitesse en decoule
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation Fused
+	// Tous les substeps dans une seule region parallele, et un seul parcours des points par substep :
+	// forces (seulement les termes actifs), collisions, grab et Verlet sont calcules pour un point avant de passer au suivant.
+	// Un point n'ecrit que dans sa propre case : pas d'ecriture partagee, pas de couleurs.
+	// Deux barrieres par substep : apres Verlet (les voisins doivent etre lus avant la rotation) et apres la rotation des buffers.
+	// Le substep est specialise a la compilation (force_pipeline.h) : Substep<Gravity, Tension, Wind, Drag, Sphere, Box...>
+	// ne contient que ses termes, sans test isEnabled ni switch sur le type des objets dans la boucle par point.
+
+	template <typename... Policies>
+	void physicCalculationSubstepedFused(ForcePipeline::Substep<Policies...>, Tissu::TissuSoA& tissu, const ColliderGroups& colliders, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		using Pipeline = ForcePipeline::Substep<Policies...>;
+		constexpr bool hasGravity = Pipeline::template has<ForcePipeline::Gravity>;
+		constexpr bool hasTension = Pipeline::template has<ForcePipeline::Tension>;
+		constexpr bool hasWind = Pipeline::template has<ForcePipeline::Wind>;
+		constexpr bool hasDrag = Pipeline::template has<ForcePipeline::Drag>;
+
+		// -------------------------------------------------------------------------------------
+		// Parametres, calcules une fois par frame
+		const GravitySettings& gravitySettings = physicsSettings.gravitySettings;
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		const WindSettings& windSettings = physicsSettings.windSettings;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+		const SelfCollisionSettings& selfCollisionSettings = physicsSettings.selfCollisionSettings;
+		const GrabSettings& grabSettings = physicsSettings.grabSettings;
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+
+		const glm::vec3 gravity = gravitySettings.directionVector * gravitySettings.amplitude;
+
+		glm::vec3 windDirection(0.0f);
+		glm::vec3 windBase(0.0f);
+		float windVariation = 1.0f;
+		if constexpr (hasWind) {
+			windDirection = glm::normalize(windSettings.directionVector);
+			windBase = windDirection * windSettings.amplitude;
+			windVariation = windOscillation(windSettings, simulationTime);
+		}
+
+		const float maxTensionForce2 = tensionSettings.maxTensionForce * tensionSettings.maxTensionForce;
+		const int grabbedIndex = grabSettings.isEnabled ? tissu.grabbedIndex : -1;
+		const float dt2 = (temporalSettings.dt * temporalSettings.dt) / temporalSettings.substeps;
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, substepDuration(temporalSettings));
+		const float floorHeight = tissu.tissuSettings.floorHeight;
+		const int count = static_cast<int>(tissu.positions.size());
+
+		const int resX = static_cast<int>(tissu.tissuSettings.resolutionX);
+		const int resY = static_cast<int>(tissu.tissuSettings.resolutionY);
+		const float restLengthX = tissu.tissuSettings.gapPointStartX;
+		const float restLengthY = tissu.tissuSettings.gapPointStartY;
+
+		// Force (bornee) du ressort a -> b, appliquee a a (tensionF est antisymetrique : b recoit l'oppose)
+		auto springForce = [&](int a, int b, float restLength) {
+			glm::vec3 force = tensionF(tissu.positions[a], tissu.positions[b], tissu.vitesse(a), tissu.vitesse(b), tensionSettings, restLength);
+			float force2 = glm::length2(force);
+			if (force2 > maxTensionForce2) {
+				force *= tensionSettings.maxTensionForce / std::sqrt(force2);
+			}
+			return force;
+		};
+
+		// -------------------------------------------------------------------------------------
+		#pragma omp parallel
+		{
+			// Chaque ressort n'est calcule qu'une fois par thread : les points sont parcourus dans l'ordre de la memoire
+			// (indice = x * resolutionY + y), la force du ressort vers (x + 1, y) est gardee dans un tampon de ligne
+			// et celle vers (x, y + 1) dans lastForceY, pour etre reutilisee (opposee) par le voisin.
+			// Seuls les ressorts qui traversent la frontiere entre deux blocs de threads sont calcules deux fois.
+			std::vector<glm::vec3> lineForcesX(hasTension ? resY : 0, glm::vec3(0.0f));
+			glm::vec3 lastForceY(0.0f);
+			int chunkStart = 0;
+			int previousIndex = -2;
+
+			for (int s = 0; s < temporalSettings.substeps; ++s) {
+				if (selfCollisionSettings.isEnabled) {
+					// Listes de voisins, puis les deux phases, partagees par toute l'equipe
+					if (selfCollisionSettings.model == SelfCollisionModel::TRIANGLE) {
+						resolveTriangleSelfCollisions(tissu, selfCollisionSettings);
+					}
+					else {
+						updateSelfCollisionNeighbors(tissu, selfCollisionSettings);
+						gatherSelfCollisionCorrections(tissu, selfCollisionSettings);
+						applySelfCollisionCorrections(tissu);
+					}
+				}
+
+				previousIndex = -2;
+				#pragma omp for schedule(static)
+				for (int i = 0; i < count; i++) {
+					const glm::vec3 position = tissu.positions[i];
+					const glm::vec3 vitesse = position - tissu.positionsOld[i];
+					const float invMass = tissu.invMasses[i];
+					glm::vec3 acceleration(0.0f); // Force, multipliee par invMass dans Verlet
+
+					// Gravité (masque sans branche : masse du point, ou 0 sous le sol et hors VERTEX_GRAVITY)
+					if constexpr (hasGravity) {
+						const bool isAffected = position.z >= floorHeight && (tissu.vertexFlags[i] & Tissu::VERTEX_GRAVITY);
+						acceleration += gravity * (isAffected ? tissu.masses[i] : 0.0f);
+					}
+
+					// Tension
+					if constexpr (hasTension) {
+						if (i != previousIndex + 1)
+							chunkStart = i;
+						previousIndex = i;
+						const int x = i / resY;
+						const int y = i % resY;
+						// Gauche : deja calcule (x - 1, y) -> (x, y) si la ligne precedente est dans le bloc du thread
+						if (x > 0)
+							acceleration += i - resY >= chunkStart ? -lineForcesX[y] : springForce(i, i - resY, restLengthX);
+						// Droite
+						if (x < resX - 1) {
+							lineForcesX[y] = springForce(i, i + resY, restLengthX);
+							acceleration += lineForcesX[y];
+						}
+						// Bas
+						if (y > 0)
+							acceleration += i - 1 >= chunkStart ? -lastForceY : springForce(i, i - 1, restLengthY);
+						// Haut
+						if (y < resY - 1) {
+							lastForceY = springForce(i, i + 1, restLengthY);
+							acceleration += lastForceY;
+						}
 					}
-					break;
+
+					// Wind
+					if constexpr (hasWind) {
+						float surfaceFactor = glm::clamp(glm::dot(tissu.normals[i], windDirection), 0.0f, 1.0f);
+						acceleration += windBase * surfaceFactor * windVariation;
+					}
+
+					// Collision : un tableau par type d'objet de la politique, reponses inline
+					addColliderForces(Pipeline{}, colliders, position, vitesse, collisionSettings, acceleration);
+
+					// Grab
+					if (i == grabbedIndex)
+						acceleration += (tissu.grabTarget - position) * grabSettings.force - grabSettings.damping * vitesse;
+
+					// Verlet
+					glm::vec3 displacement = vitesse;
+					if constexpr (hasDrag)
+						displacement = drag.damp(vitesse, invMass);
+					tissu.positionsNew[i] = verletStep(tissu, i, position, displacement, acceleration, dt2, floorHeight);
 				}
 
-				case MeshGenerator::PrimitiveType::CONE:
-				{
-					auto* cone_obj = dynamic_cast<MeshGenerator::ProceduralConeMesh*>(obj);
-					if (cone_obj)
-					{
-						applyConeCollisionResponse(LeTissu, cone_obj->meshCenter, cone_obj->rotationAxis, cone_obj->height, cone_obj->radius, physicsSettings.collisionSettings);
+				// NewPos -> Pos -> OldPos -> NewPos : simple echange de vecteurs (barriere implicite a la fin du single)
+				#pragma omp single
+				tissu.updateVertexPosition();
+			}
+		}
+	}
+
+	// Tables des instanciations (force_pipeline.h), une entree par masque de termes et jeu d'objets (selectSubstepPipeline)
+	//  - FORCES  : accumulateForces, pour les integrateurs implicite, XPBD et PD
+	//  - CLASSIC : un pas de Verlet classique (applicationForces)
+	//  - FUSED   : tous les substeps de la frame en une region parallele (physicCalculationSubstepedFused)
+	using SubstepFunction = void (*)(Tissu::TissuSoA&, const ColliderGroups&, const PhysicsSettings&, double);
+	enum class SubstepKind { FORCES, CLASSIC, FUSED };
+
+	template <SubstepKind Kind, int Index>
+	void substepEntry(Tissu::TissuSoA& tissu, const ColliderGroups& colliders, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		using Pipeline = ForcePipeline::SubstepOf<Index / ForcePipeline::colliderSetCount, static_cast<ForcePipeline::ColliderSet>(Index % ForcePipeline::colliderSetCount)>;
+		if constexpr (Kind == SubstepKind::FORCES)
+			accumulateForces(Pipeline{}, tissu, colliders, physicsSettings, simulationTime);
+		else if constexpr (Kind == SubstepKind::CLASSIC)
+			applicationForces(Pipeline{}, tissu, colliders, physicsSettings, simulationTime);
+		else
+			physicCalculationSubstepedFused(Pipeline{}, tissu, colliders, physicsSettings, simulationTime);
+	}
+
+	template <SubstepKind Kind, int... Indices>
+	constexpr std::array<SubstepFunction, sizeof...(Indices)> makeSubstepTable(std::integer_sequence<int, Indices...>)
+	{
+		return { &substepEntry<Kind, Indices>... };
+	}
+
+	constexpr int substepPipelineCount = ForcePipeline::termMaskCount * ForcePipeline::colliderSetCount;
+	inline constexpr std::array<SubstepFunction, substepPipelineCount> forceTable = makeSubstepTable<SubstepKind::FORCES>(std::make_integer_sequence<int, substepPipelineCount>{});
+	inline constexpr std::array<SubstepFunction, substepPipelineCount> classicSubstepTable = makeSubstepTable<SubstepKind::CLASSIC>(std::make_integer_sequence<int, substepPipelineCount>{});
+	inline constexpr std::array<SubstepFunction, substepPipelineCount> fusedSubstepTable = makeSubstepTable<SubstepKind::FUSED>(std::make_integer_sequence<int, substepPipelineCount>{});
+
+	// Forces du pas courant pour les reglages donnes (objets ranges une fois par frame par l'appelant)
+	void accumulateForces(Tissu::TissuSoA& tissu, const ColliderGroups& colliders, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		forceTable[selectSubstepPipeline(physicsSettings, colliders)](tissu, colliders, physicsSettings, simulationTime);
+	}
+
+	// Choix de la frame ecrits dans la console quand ils changent (instanciation du substep, noyaux SIMD, substeps adaptatifs).
+	// Appele hors des regions paralleles : les tissus d'une Scene calcules en parallele n'entremelent pas leurs lignes
+	void reportFrameChoices(Tissu::TissuSoA& tissu, const std::string& label)
+	{
+		if (tissu.substepPipelineIndex != tissu.reportedSubstepPipelineIndex) {
+			if (tissu.substepPipelineIndex >= 0)
+				std::cout << "   " << label << "Substep pipeline: " << ForcePipeline::describe(tissu.substepPipelineIndex) << std::endl;
+			tissu.reportedSubstepPipelineIndex = tissu.substepPipelineIndex;
+		}
+		if (tissu.simdKernels != tissu.reportedSimdKernels) {
+			if (tissu.simdKernels)
+				std::cout << "   " << label << "SIMD kernels: " << Simd::toString(tissu.simdKernels->instructionSet) << std::endl;
+			tissu.reportedSimdKernels = tissu.simdKernels;
+		}
+		if (tissu.adaptiveSubsteps != tissu.reportedAdaptiveSubsteps) {
+			if (tissu.adaptiveSubsteps > 0)
+				std::cout << "   " << label << "Adaptive substeps: " << tissu.adaptiveSubsteps << std::endl;
+			tissu.reportedAdaptiveSubsteps = tissu.adaptiveSubsteps;
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Sol des integrateurs a grands pas (implicite, Projective Dynamics, XPBD), sans branche :
+	// un point libre qui passe sous le sol y est pose, sans vitesse, et devient fixe
+	inline void landOnFloor(Tissu::TissuSoA& tissu, size_t i, float floorHeight, glm::vec3& position, glm::vec3& velocity)
+	{
+		const bool lands = tissu.invMasses[i] > 0.0f && position.z <= floorHeight;
+		position.z = lands ? floorHeight : position.z;
+		velocity = lands ? glm::vec3(0.0f) : velocity;
+		tissu.markLanded(i, lands);
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation Implicit (Euler implicite, Baraff-Witkin)
+	// Un pas lineairise : (M - h dF/dv - h² dF/dx) dv = h (F + h dF/dx v)   (M : masses des points, diagonale)
+	// Les jacobiennes sont assemblees par blocs 3x3 sur le motif CSR des ressorts, puis resolues par gradient conjugue
+	// preconditionne block-Jacobi (implicit_solver.h). Quelques grands pas par frame au lieu de substeps pas de Verlet.
+	// Le temps simule par frame reste celui de Verlet, dt * sqrt(substeps), et vitesse() garde son unite :
+	// deplacement sur un substep de duree dt / sqrt(substeps). Les forces sont celles de accumulateForces.
+	void physicCalculationImplicit(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		const ImplicitSettings& implicitSettings = physicsSettings.implicitSettings;
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+		const GrabSettings& grabSettings = physicsSettings.grabSettings;
+
+		const float substepDuration = temporalSettings.dt / std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const float frameDuration = temporalSettings.dt * std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const int steps = std::max(1, implicitSettings.steps);
+		const float h = frameDuration / steps;
+		const float h2 = h * h;
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, h);
+		const float tensionDamping = tensionSettings.damping * substepDuration; // tensionF amortit un deplacement par substep
+		const float floorHeight = tissu.tissuSettings.floorHeight;
+		const int count = static_cast<int>(tissu.positions.size());
+		const int grabbedIndex = grabSettings.isEnabled ? tissu.grabbedIndex : -1;
+
+		ImplicitSolver::BlockSystem& system = tissu.implicitSystem;
+		system.bindPattern(tissu.springOffsets, tissu.springNeighbors);
+
+		std::vector<ColliderShape> colliders;
+		if (collisionSettings.isEnabled)
+			colliders = buildColliderShapes(listObj, collisionSettings);
+		const ColliderGroups colliderGroups = groupColliderShapes(colliders);
+
+		for (int step = 0; step < steps; ++step) {
+			// -------------------------------------------------------------------------------------
+			// Forces F
+			accumulateForces(tissu, colliderGroups, physicsSettings, simulationTime);
+
+			// -------------------------------------------------------------------------------------
+			// Assemblage : chaque point remplit sa ligne (bloc diagonal + blocs de ses voisins CSR), pas d'ecriture partagee
+			// Points fixes elimines sans branche : S A S + (I - S) et S b, avec S = invMass * masse (1 libre, 0 fixe).
+			// Une ligne fixe devient l'identite avec un second membre nul : le gradient conjugue (parti de 0) y donne dv = 0 exactement
+			#pragma omp parallel for
+			for (int i = 0; i < count; i++) {
+				const uint32_t rowBegin = tissu.springOffsets[i];
+				const uint32_t rowEnd = tissu.springOffsets[i + 1];
+				const float freedom = tissu.invMasses[i] * tissu.masses[i];
+
+				const glm::vec3 position = tissu.positions[i];
+				const glm::vec3 vitesse = tissu.vitesse(i);
+				const glm::vec3 velocity = vitesse / substepDuration;
+				glm::mat3 diagonal(tissu.masses[i]);
+				glm::vec3 jacobianTimesVelocity(0.0f); // (dF/dx v)_i
+
+				// Ressorts : dF_i/dx_n = k (max(L - L0, 0) I + d d^T / L), dF_i/dv_n = c d d^T  (d = x_n - x_i, non normalise comme dans tensionF)
+				// Le terme en (L - L0) est coupe en compression pour garder la matrice definie positive,
+				// et la jacobienne d'un ressort borne par maxTensionForce est reduite du meme facteur que sa force
+				for (uint32_t k = rowBegin; k < rowEnd; k++) {
+					const uint32_t n = tissu.springNeighbors[k];
+					glm::mat3 block(0.0f);
+					if (tensionSettings.isEnabled) {
+						glm::vec3 d = tissu.positions[n] - position;
+						float length = glm::length(d);
+						if (length > 1e-6f) {
+							glm::vec3 force = tensionF(position, tissu.positions[n], vitesse, tissu.vitesse(n), tensionSettings, tissu.springRestLengths[k]);
+							float forceLength = glm::length(force);
+							float scale = forceLength > tensionSettings.maxTensionForce ? tensionSettings.maxTensionForce / forceLength : 1.0f;
+
+							glm::mat3 ddT = glm::outerProduct(d, d);
+							glm::mat3 stiffness = (scale * tensionSettings.force) * (std::max(length - tissu.springRestLengths[k], 0.0f) * glm::mat3(1.0f) + ddT / length);
+							glm::mat3 damping = (scale * tensionDamping) * ddT;
+							block = h * damping + h2 * stiffness;
+
+							glm::vec3 neighborVelocity = tissu.vitesse(n) / substepDuration;
+							jacobianTimesVelocity += stiffness * (neighborVelocity - velocity);
+						}
 					}
-					break;
+					diagonal += block;
+					system.offDiagonal[k] = (freedom * tissu.invMasses[n] * tissu.masses[n]) * -block;
 				}
 
-				case MeshGenerator::PrimitiveType::CYLINDER:
-				{
-					auto* cylinder_obj = dynamic_cast<MeshGenerator::ProceduralCylinderMesh*>(obj);
-					if (cylinder_obj)
-					{
-						applyCylinderCollisionResponse(LeTissu, cylinder_obj->meshCenter, cylinder_obj->radius, cylinder_obj->height, cylinder_obj->rotationAxis, physicsSettings.collisionSettings);
+				// Collisions : reponse le long de la normale, dF/dx = -k n n^T, dF/dv = -c n n^T
+				for (const ColliderShape& collider : colliders) {
+					glm::vec3 force = colliderForce(collider, position, vitesse, collisionSettings);
+					float force2 = glm::length2(force);
+					if (force2 > 1e-12f) {
+						glm::vec3 normal = force / std::sqrt(force2);
+						float stiffness, damping;
+						colliderNormalCoefficients(collider, collisionSettings, stiffness, damping);
+						diagonal += (h2 * stiffness + h * damping * substepDuration) * glm::outerProduct(normal, normal);
+						jacobianTimesVelocity -= stiffness * glm::dot(normal, velocity) * normal;
 					}
-					break;
 				}
+
+				// Grab : ressort vers la cible, dF/dx = -force I, dF/dv = -damping I
+				if (i == grabbedIndex) {
+					diagonal += (h2 * grabSettings.force + h * grabSettings.damping * substepDuration) * glm::mat3(1.0f);
+					jacobianTimesVelocity -= grabSettings.force * velocity;
 				}
+
+				system.diagonal[i] = freedom * diagonal + (1.0f - freedom) * glm::mat3(1.0f);
+				system.rhs[i] = (freedom * h) * (tissu.accelerations[i] + h * jacobianTimesVelocity);
+			}
+
+			// -------------------------------------------------------------------------------------
+			// Resolution
+			ImplicitSolver::solveConjugateGradient(system, implicitSettings.maxIterations, implicitSettings.tolerance);
+
+			// -------------------------------------------------------------------------------------
+			// Mise a jour : v += dv (reduit par le frottement de l'air), x += h v, puis positionsOld = x - v * substepDuration pour garder vitesse() coherent
+			#pragma omp parallel for
+			for (int i = 0; i < count; i++) {
+				glm::vec3 velocity = tissu.vitesse(i) / substepDuration + system.solution[i];
+				velocity *= drag.factor(h * glm::length(velocity), tissu.invMasses[i]);
+				glm::vec3 position = tissu.positions[i] + h * velocity;
+				landOnFloor(tissu, i, floorHeight, position, velocity);
+				tissu.positions[i] = position;
+				tissu.positionsOld[i] = position - velocity * substepDuration;
 			}
 		}
-		
-		// Grab
-		if (physicsSettings.grabSettings.isEnabled)
-			calculForceGrab(LeTissu, physicsSettings.grabSettings);
+	}
 
-		// -------------------------------------------------------------------------------------
-		//Application de l'intégration de Verlet (+pression/+réaliste)
-		//x(t + 1) = x(t) + [x(t) - x(t - 1)] + a(t) * dt²               [x(t) - x(t - 1)] c'est la vitesse
+	// ------------------------------------------------------------------------------------------------
+	// Parties communes des integrateurs par positions (Projective Dynamics, XPBD)
+
+	// Tension et objets sont des contraintes ici : accumulateForces ne calcule que les forces externes
+	inline PhysicsSettings externalForceSettings(const PhysicsSettings& physicsSettings)
+	{
+		PhysicsSettings externalSettings = physicsSettings;
+		externalSettings.tensionSettings.isEnabled = false;
+		externalSettings.collisionSettings.isEnabled = false;
+		return externalSettings;
+	}
+
+	// 1 / raideur de la reponse de chaque objet : force sans vitesse -> correction de position
+	std::vector<float> buildColliderCompliances(const std::vector<ColliderShape>& colliders, const CollisionSettings& collisionSettings)
+	{
+		std::vector<float> compliances;
+		compliances.reserve(colliders.size());
+		for (const ColliderShape& collider : colliders) {
+			float stiffness, damping;
+			colliderNormalCoefficients(collider, collisionSettings, stiffness, damping);
+			compliances.push_back(stiffness > 0.0f ? 1.0f / stiffness : 0.0f);
+		}
+		return compliances;
+	}
+
+	// Non-penetration : la reponse d'un objet sans vitesse vaut normale * profondeur * raideur.
+	// La correction est ponderee par invMass * masse (1 sur un point libre, 0 sur un point fixe)
+	void projectColliders(const Tissu::TissuSoA& tissu, const std::vector<ColliderShape>& colliders, const std::vector<float>& compliances,
+		const CollisionSettings& collisionSettings, std::vector<glm::vec3>& points)
+	{
+		if (colliders.empty())
+			return;
 		#pragma omp parallel for
-		for (int i = 0; i < LeTissu.accelerations.size(); i++) {
-			if (!LeTissu.isFixed[i] && LeTissu.positions[i].z > LeTissu.tissuSettings.floorHeight)
-			{
-				LeTissu.positionsNew[i] = LeTissu.positions[i] + LeTissu.vitesses[i] + LeTissu.accelerations[i] * ((physicsSettings.temporalSettings.dt * physicsSettings.temporalSettings.dt) / physicsSettings.temporalSettings.substeps);
+		for (int i = 0; i < static_cast<int>(points.size()); i++) {
+			const float weight = tissu.invMasses[i] * tissu.masses[i];
+			for (size_t c = 0; c < colliders.size(); c++)
+				points[i] += colliderForce(colliders[c], points[i], glm::vec3(0.0f), collisionSettings) * (compliances[c] * weight);
+		}
+	}
+
+	// Fin d'un pas de duree h vers les positions next : v = (next - x) / h (reduit par le frottement de l'air),
+	// puis positionsOld = next - v * substepDuration pour garder vitesse() coherent.
+	// Un point fixe a next == x (prediction sans vitesse ni invMass, corrections ponderees par invMass) : v = 0
+	void commitPositionStep(Tissu::TissuSoA& tissu, const std::vector<glm::vec3>& next, const DragTerms& drag, float h, float substepDuration)
+	{
+		const float floorHeight = tissu.tissuSettings.floorHeight;
+		#pragma omp parallel for
+		for (int i = 0; i < static_cast<int>(next.size()); i++) {
+			const float invMass = tissu.invMasses[i];
+			glm::vec3 position = next[i];
+			glm::vec3 velocity = drag.apply(position - tissu.positions[i], invMass) / h;
+			landOnFloor(tissu, i, floorHeight, position, velocity);
+			tissu.positions[i] = position;
+			tissu.positionsOld[i] = position - velocity * substepDuration;
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation Projective Dynamics
+	// Energie d'un ressort : w/2 |x_b - x_a - p|^2, avec p = L0 * (x_b - x_a) / |x_b - x_a| (projection locale)
+	// et w = force * L0, la raideur effective de tensionF (comme pour XPBD).
+	// Systeme global : (M / h^2 + sum w L) x = M s / h^2 + sum w A^T p (M : masses des points), la matrice est constante
+	// tant que h, la raideur, les masses et les points fixes ne changent pas : elle est factorisee une fois (projective_solver.h).
+	// Les points fixes sont elimines (ligne identite, leur contribution passe au second membre).
+
+	// (Re)construit et factorise la matrice globale
+	bool buildProjectiveFactorization(Tissu::TissuSoA& tissu, float h, float stiffness)
+	{
+		ProjectiveSolver::Factorization& factorization = tissu.projectiveFactorization;
+		const size_t count = tissu.positions.size();
+
+		// Structure : une fois par topologie (les points fixes gardent leur place dans le motif, avec des zeros)
+		if (!factorization.isAnalyzed || factorization.springCount != tissu.springNeighbors.size() || factorization.cholesky.count != count) {
+			size_t reach = 1;
+			for (size_t i = 0; i < count; i++)
+				for (uint32_t k = tissu.springOffsets[i]; k < tissu.springOffsets[i + 1]; k++) {
+					const size_t n = tissu.springNeighbors[k];
+					reach = std::max(reach, static_cast<size_t>(std::abs(tissu.gridX(n) - tissu.gridX(i))));
+					reach = std::max(reach, static_cast<size_t>(std::abs(tissu.gridY(n) - tissu.gridY(i))));
+				}
+			// La dissection travaille sur les cases x * resolutionY + y : on passe aux indices des points
+			std::vector<uint32_t> order = ProjectiveSolver::nestedDissectionOrder(tissu.tissuSettings.resolutionX, tissu.tissuSettings.resolutionY, reach);
+			if (!tissu.gridToIndex.empty())
+				for (uint32_t& cell : order)
+					cell = tissu.gridToIndex[cell];
+			factorization.cholesky.analyze(order, tissu.springOffsets, tissu.springNeighbors);
+			factorization.isAnalyzed = true;
+			factorization.springCount = tissu.springNeighbors.size();
+		}
+
+		// Valeurs : M / h^2 + sum w L, points fixes elimines (ligne et colonne identite)
+		const float inertiaWeight = 1.0f / (h * h);
+		factorization.diagonal.assign(count, 1.0f);
+		factorization.offDiagonal.assign(tissu.springNeighbors.size(), 0.0f);
+		for (size_t i = 0; i < count; i++) {
+			if (tissu.isFixed(i))
+				continue;
+			float diagonal = inertiaWeight * tissu.masses[i];
+			for (uint32_t k = tissu.springOffsets[i]; k < tissu.springOffsets[i + 1]; k++) {
+				float weight = stiffness * tissu.springRestLengths[k];
+				diagonal += weight;
+				if (!tissu.isFixed(tissu.springNeighbors[k]))
+					factorization.offDiagonal[k] = -weight;
 			}
-			else if (!LeTissu.isFixed[i] && LeTissu.positions[i].z <= LeTissu.tissuSettings.floorHeight)
-			{
-				LeTissu.isFixed[i] = true;
-				LeTissu.positionsNew[i] = LeTissu.positions[i]; // point fixe
-				LeTissu.positionsNew[i].z = LeTissu.tissuSettings.floorHeight;
+			factorization.diagonal[i] = diagonal;
+		}
+
+		factorization.isValid = factorization.cholesky.factorize(factorization.diagonal, tissu.springOffsets, tissu.springNeighbors, factorization.offDiagonal);
+		factorization.stepDuration = h;
+		factorization.stiffness = stiffness;
+		factorization.invMasses = tissu.invMasses;
+		factorization.inertia.resize(count);
+		factorization.rhs.resize(count);
+		factorization.factorizationCount++;
+
+		if (!factorization.isValid)
+			std::cerr << "ERROR: Projective Dynamics: Matrix is not positive definite" << std::endl;
+		return factorization.isValid;
+	}
+
+	// Vrai si la factorisation en cache correspond encore au tissu et aux reglages
+	bool isProjectiveFactorizationCurrent(const Tissu::TissuSoA& tissu, float h, float stiffness)
+	{
+		const ProjectiveSolver::Factorization& factorization = tissu.projectiveFactorization;
+		if (!factorization.isValid || factorization.stepDuration != h || factorization.stiffness != stiffness
+			|| factorization.springCount != tissu.springNeighbors.size())
+			return false;
+		return factorization.invMasses == tissu.invMasses; // Points fixes (0) et masses
+	}
+
+	void physicCalculationProjective(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		const ProjectiveSettings& projectiveSettings = physicsSettings.projectiveSettings;
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+
+		const float substepDuration = temporalSettings.dt / std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const float frameDuration = temporalSettings.dt * std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const int steps = std::max(1, projectiveSettings.steps);
+		const int iterations = std::max(1, projectiveSettings.iterations);
+		const float h = frameDuration / steps;
+		const float h2 = h * h;
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, h);
+		const float inertiaWeight = 1.0f / h2;
+		const float stiffness = tensionSettings.isEnabled ? tensionSettings.force : 0.0f;
+		const int count = static_cast<int>(tissu.positions.size());
+
+		const PhysicsSettings externalSettings = externalForceSettings(physicsSettings);
+		std::vector<ColliderShape> colliders;
+		if (collisionSettings.isEnabled)
+			colliders = buildColliderShapes(listObj, collisionSettings);
+		const std::vector<float> colliderCompliances = buildColliderCompliances(colliders, collisionSettings);
+
+		ProjectiveSolver::Factorization& factorization = tissu.projectiveFactorization;
+		// positionsNew sert d'iteree courante
+		std::vector<glm::vec3>& current = tissu.positionsNew;
+
+		for (int step = 0; step < steps; ++step) {
+			// Un point qui touche le sol devient fixe : seul cas (avec la console) ou la matrice change en cours de route
+			if (!isProjectiveFactorizationCurrent(tissu, h, stiffness) && !buildProjectiveFactorization(tissu, h, stiffness))
+				return;
+
+			accumulateForces(tissu, ColliderGroups{}, externalSettings, simulationTime);
+
+			// -------------------------------------------------------------------------------------
+			// Prediction inertielle s = x + h v + h^2 F / m, point de depart des iterations (s = x sur un point fixe : v = 0, invMass = 0)
+			#pragma omp parallel for
+			for (int i = 0; i < count; i++) {
+				glm::vec3 inertia = tissu.positions[i] + h * (tissu.vitesse(i) / substepDuration) + (h2 * tissu.invMasses[i]) * tissu.accelerations[i];
+				factorization.inertia[i] = inertia;
+				current[i] = inertia;
 			}
-			else
-			{
-				LeTissu.positionsNew[i] = LeTissu.positions[i]; // point fixe
+
+			for (int iteration = 0; iteration < iterations; ++iteration) {
+				// -------------------------------------------------------------------------------------
+				// Etape locale (projection de chaque ressort) et second membre, ligne par ligne
+				// Ponderes par invMass * masse (1 libre, 0 fixe) : une ligne fixe garde sa position, un voisin fixe passe au second membre
+				#pragma omp parallel for
+				for (int i = 0; i < count; i++) {
+					const float freedom = tissu.invMasses[i] * tissu.masses[i];
+					glm::vec3 rhs = (inertiaWeight * tissu.masses[i]) * factorization.inertia[i];
+					for (uint32_t k = tissu.springOffsets[i]; k < tissu.springOffsets[i + 1]; k++) {
+						uint32_t n = tissu.springNeighbors[k];
+						float weight = stiffness * tissu.springRestLengths[k];
+						glm::vec3 d = current[i] - current[n];
+						float length = glm::length(d);
+						if (length > 1e-6f)
+							rhs += (weight * tissu.springRestLengths[k] / length) * d;
+						rhs += (weight * (1.0f - tissu.invMasses[n] * tissu.masses[n])) * tissu.positions[n];
+					}
+					factorization.rhs[i] = freedom * rhs + (1.0f - freedom) * tissu.positions[i];
+				}
+
+				// -------------------------------------------------------------------------------------
+				// Etape globale : descente / remontee sur la matrice factorisee
+				factorization.cholesky.solve(factorization.rhs);
+				std::swap(current, factorization.rhs);
+
+				// -------------------------------------------------------------------------------------
+				// Non-penetration
+				projectColliders(tissu, colliders, colliderCompliances, collisionSettings, current);
 			}
+
+			// -------------------------------------------------------------------------------------
+			// Mise a jour : v = (x' - x) / h
+			commitPositionStep(tissu, current, drag, h, substepDuration);
 		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation XPBD (Position Based Dynamics etendu, compliance)
+	// Chaque ressort structurel devient une contrainte de distance |x_b - x_a| = L0, de compliance 1 / (force * L0) :
+	// tensionF applique force * (L - L0) * d avec d non normalise, soit une raideur effective force * |d| ~ force * L0.
+	// Projection de Gauss-Seidel par couleur (springColorOffsets) : les aretes d'une couleur ne partagent aucun point
+	// et sont projetees en parallele. Les objets sont des contraintes de non-penetration, le reste (gravite, vent, grab)
+	// passe par accumulateForces. Le temps simule par frame reste dt * sqrt(substeps), decoupe en xpbd.substeps pas.
+	void physicCalculationXpbd(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		const XpbdSettings& xpbdSettings = physicsSettings.xpbdSettings;
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+
+		const float substepDuration = temporalSettings.dt / std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const float frameDuration = temporalSettings.dt * std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const int steps = std::max(1, xpbdSettings.substeps);
+		const int iterations = std::max(1, xpbdSettings.iterations);
+		const float h = frameDuration / steps;
+		const float h2 = h * h;
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, h);
+		const int count = static_cast<int>(tissu.positions.size());
+		const int edgeCount = static_cast<int>(tissu.springEdgeA.size());
+
+		const PhysicsSettings externalSettings = externalForceSettings(physicsSettings);
+		std::vector<ColliderShape> colliders;
+		if (collisionSettings.isEnabled)
+			colliders = buildColliderShapes(listObj, collisionSettings);
+		const std::vector<float> colliderCompliances = buildColliderCompliances(colliders, collisionSettings);
+
+		// Compliance (alphaTilde = alpha / h^2) et amortissement de Macklin (gamma = alpha * beta / h), a diviser / multiplier par L0
+		// beta reprend l'amortissement de tensionF : damping * |d|^2 sur une vitesse par substep
+		const float alphaTildeScale = 1.0f / (tensionSettings.force * h2);
+		const float gammaScale = tensionSettings.damping * substepDuration / (tensionSettings.force * h);
+
+		std::vector<float>& lambdas = tissu.constraintLambdas;
+		lambdas.resize(edgeCount);
+
+		// positionsNew sert de position predite
+		std::vector<glm::vec3>& predicted = tissu.positionsNew;
+
+		for (int step = 0; step < steps; ++step) {
+			accumulateForces(tissu, ColliderGroups{}, externalSettings, simulationTime);
+
+			// -------------------------------------------------------------------------------------
+			// Prediction : p = x + h v + h^2 F / m (p = x sur un point fixe : v = 0, invMass = 0)
+			#pragma omp parallel for
+			for (int i = 0; i < count; i++) {
+				glm::vec3 velocity = tissu.vitesse(i) / substepDuration;
+				predicted[i] = tissu.positions[i] + h * velocity + (h2 * tissu.invMasses[i]) * tissu.accelerations[i];
+			}
+			std::fill(lambdas.begin(), lambdas.end(), 0.0f);
+
+			for (int iteration = 0; iteration < iterations; ++iteration) {
+				// -------------------------------------------------------------------------------------
+				// Contraintes de distance, couleur par couleur
+				if (tensionSettings.isEnabled) {
+					for (int color = 0; color < Tissu::TissuSoA::springColorCount; ++color) {
+						const int begin = static_cast<int>(tissu.springColorOffsets[color]);
+						const int end = static_cast<int>(tissu.springColorOffsets[color + 1]);
+						#pragma omp parallel for schedule(static)
+						for (int e = begin; e < end; e++) {
+							const uint32_t a = tissu.springEdgeA[e];
+							const uint32_t b = tissu.springEdgeB[e];
+							const float wa = tissu.invMasses[a];
+							const float wb = tissu.invMasses[b];
+							const float w = wa + wb;
+							if (w == 0.0f)
+								continue;
+
+							glm::vec3 d = predicted[b] - predicted[a];
+							float length = glm::length(d);
+							if (length < 1e-6f)
+								continue;
+							glm::vec3 n = d / length;
+							const float restLength = tissu.springEdgeRestLengths[e];
+
+							float alphaTilde = alphaTildeScale / restLength;
+							float gamma = gammaScale * restLength;
+
+							float constraint = length - restLength;
+							float constraintVelocity = glm::dot(n, (predicted[b] - tissu.positions[b]) - (predicted[a] - tissu.positions[a]));
+							float deltaLambda = (-constraint - alphaTilde * lambdas[e] - gamma * constraintVelocity) / ((1.0f + gamma) * w + alphaTilde);
+							lambdas[e] += deltaLambda;
+
+							predicted[a] -= (wa * deltaLambda) * n;
+							predicted[b] += (wb * deltaLambda) * n;
+						}
+					}
+				}
+
+				// -------------------------------------------------------------------------------------
+				// Non-penetration
+				projectColliders(tissu, colliders, colliderCompliances, collisionSettings, predicted);
+			}
+
+			// -------------------------------------------------------------------------------------
+			// Mise a jour : v = (p - x) / h
+			commitPositionStep(tissu, predicted, drag, h, substepDuration);
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation SIMD (layout SoA aligne + noyaux AVX2/AVX-512, voir simd_kernels.h)
+	// Couvre gravite, tension, vent (par point ou par triangle), collisions sphere/boite, grab et Verlet.
+	// Les autres objets de collision et l'auto-collision passent par le chemin classique.
+	bool canUseSimdKernels(const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings)
+	{
+		if (physicsSettings.selfCollisionSettings.isEnabled)
+			return false;
+		if (physicsSettings.tensionSettings.shear.isEnabled || physicsSettings.tensionSettings.bending.isEnabled)
+			return false;
+		if (physicsSettings.collisionSettings.isEnabled) {
+			for (MeshGenerator::MeshGenerator* obj : listObj) {
+				if (obj->type != MeshGenerator::PrimitiveType::SPHERE && obj->type != MeshGenerator::PrimitiveType::BOX)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void physicCalculationSubstepedSimd(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		const Simd::KernelTable& kernels = Simd::selectKernels(physicsSettings.simdSettings.instructionSet);
+		tissu.simdKernels = &kernels; // Ecrit par reportFrameChoices, hors de la boucle parallele de la Scene
+		Simd::SplitLayout& layout = tissu.splitLayout;
+		tissu.packSplitLayout();
 
 		// -------------------------------------------------------------------------------------
-		// Implementation Double Buffering pour limiter les déformations artificielles causées par le traitement séquentiel
-		LeTissu.updateVertexPosition();  // (0.0f) -> NewPos -> Pos -> OldPos -> *Void*
-		LeTissu.computeVitesses();
+		// Parametres, calcules une fois par frame
+		const GravitySettings& gravitySettings = physicsSettings.gravitySettings;
+		glm::vec3 gravity = gravitySettings.directionVector * gravitySettings.amplitude;
+		Simd::GravityParams gravityParams{ gravity.x, gravity.y, gravity.z, tissu.tissuSettings.floorHeight };
+
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		Simd::TensionParams tensionParams{ tensionSettings.force, tensionSettings.damping, tensionSettings.maxTensionForce, tissu.tissuSettings.gapPointStartX, tissu.tissuSettings.gapPointStartY };
+
+		const WindSettings& windSettings = physicsSettings.windSettings;
+		glm::vec3 windDirection = glm::normalize(windSettings.directionVector);
+		const float windVariation = windOscillation(windSettings, simulationTime);
+		Simd::WindParams windParams{ windDirection.x, windDirection.y, windDirection.z, windSettings.amplitude * windVariation };
+		const bool isTriangleWind = windSettings.model == WindModel::TRIANGLE;
+		const Simd::AeroWindParams aeroParams = aeroWindParams(windSettings, substepDuration(physicsSettings.temporalSettings), simulationTime);
+
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+		std::vector<Simd::SphereParams> spheres;
+		std::vector<Simd::BoxParams> boxes;
+		for (MeshGenerator::MeshGenerator* obj : listObj) {
+			if (auto* sphere_obj = dynamic_cast<MeshGenerator::ProceduralSphereMesh*>(obj)) {
+				spheres.push_back({ sphere_obj->meshCenter.x, sphere_obj->meshCenter.y, sphere_obj->meshCenter.z,
+					sphere_obj->radius + collisionSettings.antiClippingGap, collisionSettings.stiffness });
+			}
+			else if (auto* box_obj = dynamic_cast<MeshGenerator::ProceduralBoxMesh*>(obj)) {
+				glm::mat3 rotationMatrix = boxRotationMatrix(box_obj->rotationAxis);
+				glm::vec3 halfSize = boxCollisionHalfSize(box_obj->size, collisionSettings);
+				Simd::BoxParams box{ box_obj->meshCenter.x, box_obj->meshCenter.y, box_obj->meshCenter.z, halfSize.x, halfSize.y, halfSize.z, {}, collisionSettings.stiffness };
+				for (int c = 0; c < 3; c++)
+					for (int r = 0; r < 3; r++)
+						box.rotation[c * 3 + r] = rotationMatrix[c][r];
+				boxes.push_back(box);
+			}
+		}
+
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, substepDuration(temporalSettings));
+		Simd::VerletParams verletParams{ (temporalSettings.dt * temporalSettings.dt) / temporalSettings.substeps, tissu.tissuSettings.floorHeight,
+			drag.isEnabled ? drag.linear : 0.0f, drag.isEnabled ? drag.quadratic : 0.0f };
+
+		// -------------------------------------------------------------------------------------
+		for (int s = 0; s < temporalSettings.substeps; ++s) {
+			kernels.resetAcceleration(layout);
+			if (gravitySettings.isEnabled)
+				kernels.gravity(layout, gravityParams);
+			if (tensionSettings.isEnabled)
+				kernels.tension(layout, tensionParams);
+			if (windSettings.isEnabled && isTriangleWind)
+				kernels.windTriangles(layout, aeroParams);
+			else if (windSettings.isEnabled)
+				kernels.wind(layout, windParams);
+			if (collisionSettings.isEnabled) {
+				for (const Simd::SphereParams& sphere : spheres)
+					kernels.sphereCollision(layout, sphere);
+				for (const Simd::BoxParams& box : boxes)
+					kernels.boxCollision(layout, box);
+			}
+			// Grab : un seul point, en scalaire
+			if (physicsSettings.grabSettings.isEnabled && tissu.grabbedIndex != -1) {
+				size_t g = static_cast<size_t>(tissu.grabbedIndex);
+				glm::vec3 position(layout.positions.x[g], layout.positions.y[g], layout.positions.z[g]);
+				glm::vec3 vel(layout.velocities.x[g], layout.velocities.y[g], layout.velocities.z[g]);
+				glm::vec3 totalForce = (tissu.grabTarget - position) * physicsSettings.grabSettings.force - physicsSettings.grabSettings.damping * vel;
+				layout.accelerations.x[g] += totalForce.x;
+				layout.accelerations.y[g] += totalForce.y;
+				layout.accelerations.z[g] += totalForce.z;
+			}
+			kernels.verlet(layout, verletParams);
+		}
+
+		tissu.unpackSplitLayout();
 	}
 
-	// Main Calculation Substep
-	void physicCalculationSubsteped(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings) {
+	// ------------------------------------------------------------------------------------------------
+	// Main Calculation Precision
+	// Verlet classique avec les positions en double (tissu.preciseState) et les forces en ForceScalar :
+	//   Precision::DOUBLE -> ForceScalar = double, Precision::MIXED -> ForceScalar = float
+	// Les ressorts ne lisent que des differences de positions et de vitesses, calculees dans le type des positions puis arrondies :
+	// en mixte, l'allongement d'un ressort court loin de l'origine n'est pas perdu dans l'arrondi des positions.
+	// Les objets de collision, les normales et le grab restent en float : leurs reponses sont evaluees en float dans tous les modes.
+	// Les buffers float du tissu sont resynchronises en debut (pullPreciseState) et en fin de frame (pushPreciseState).
+	template <int DX, int DY, typename PositionScalar, typename ForceScalar>
+	void applyGridSpringPrecise(const Tissu::TissuSoA& tissu, const Tissu::VerletState<PositionScalar>& state, const TensionSettings& springSettings,
+		ForceScalar restLength, std::vector<glm::vec<3, ForceScalar>>& accelerations)
+	{
+		using ForceVec = glm::vec<3, ForceScalar>;
+		using Range = GridStencil::Range<DX, DY>;
+		const Range range(static_cast<int>(tissu.tissuSettings.resolutionX), static_cast<int>(tissu.tissuSettings.resolutionY));
+		const ForceScalar maxTensionForce = static_cast<ForceScalar>(springSettings.maxTensionForce);
+
+		// Memes blocs de lignes que applyGridSpring ; gridIndex couvre toutes les numerotations
+		#pragma omp parallel
+		for (int phase = 0; phase < Range::phaseCount; phase++) {
+			#pragma omp for
+			for (int block = phase; block < range.blockCount; block += Range::phaseCount) {
+				const int rowBegin = block * Range::rowsPerBlock;
+				const int rowEnd = std::min(rowBegin + Range::rowsPerBlock, range.rowEnd);
+				for (int x = rowBegin; x < rowEnd; x++) {
+					for (int y = range.columnBegin; y < range.columnEnd; y++) {
+						const size_t a = tissu.gridIndex(x, y);
+						const size_t b = tissu.gridIndex(x + DX, y + DY);
+
+						const ForceVec direction(state.positions[b] - state.positions[a]);
+						const ForceVec relativeVelocity(state.vitesse(b) - state.vitesse(a));
+						ForceVec force = tensionF(ForceVec(0), direction, ForceVec(0), relativeVelocity, springSettings, restLength);
+
+						if (glm::length(force) > maxTensionForce) {
+							force = glm::normalize(force) * maxTensionForce;
+						}
+
+						accelerations[a] += force;
+						accelerations[b] -= force;
+					}
+				}
+			}
+		}
+	}
+
+	template <typename PositionScalar, typename ForceScalar, typename... Offsets>
+	void applyGridStencilPrecise(GridStencil::Stencil<Offsets...>, const Tissu::TissuSoA& tissu, const Tissu::VerletState<PositionScalar>& state,
+		const TensionSettings& springSettings, std::vector<glm::vec<3, ForceScalar>>& accelerations)
+	{
+		(applyGridSpringPrecise<Offsets::dx, Offsets::dy>(tissu, state, springSettings,
+			static_cast<ForceScalar>(gridSpringRestLength<Offsets::dx, Offsets::dy>(tissu)), accelerations), ...);
+	}
+
+	template <typename ForceScalar>
+	void physicCalculationPrecise(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime)
+	{
+		using PositionScalar = double;
+		using PositionVec = glm::vec<3, PositionScalar>;
+		using ForceVec = glm::vec<3, ForceScalar>;
+
+		// -------------------------------------------------------------------------------------
+		// Parametres, calcules une fois par frame
+		const GravitySettings& gravitySettings = physicsSettings.gravitySettings;
+		const TensionSettings& tensionSettings = physicsSettings.tensionSettings;
+		const WindSettings& windSettings = physicsSettings.windSettings;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+		const SelfCollisionSettings& selfCollisionSettings = physicsSettings.selfCollisionSettings;
+		const GrabSettings& grabSettings = physicsSettings.grabSettings;
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+
+		const ForceVec gravity(gravitySettings.directionVector * gravitySettings.amplitude);
+
+		const bool isVertexWind = windSettings.isEnabled && windSettings.model == WindModel::VERTEX;
+		const bool isTriangleWind = windSettings.isEnabled && windSettings.model == WindModel::TRIANGLE;
+		glm::vec3 windDirection(0.0f);
+		glm::vec3 windBase(0.0f);
+		float windVariation = 1.0f;
+		if (isVertexWind) {
+			windDirection = glm::normalize(windSettings.directionVector);
+			windBase = windDirection * windSettings.amplitude;
+			windVariation = windOscillation(windSettings, simulationTime);
+		}
+
+		std::vector<ColliderShape> colliders;
+		if (collisionSettings.isEnabled)
+			colliders = buildColliderShapes(listObj, collisionSettings);
+
+		TensionSettings shearSettings = tensionSettings;
+		shearSettings.force = tensionSettings.shear.force;
+		TensionSettings bendingSettings = tensionSettings;
+		bendingSettings.force = tensionSettings.bending.force;
+
+		const int grabbedIndex = grabSettings.isEnabled ? tissu.grabbedIndex : -1;
+		const PositionScalar dt2 = static_cast<PositionScalar>(temporalSettings.dt) * temporalSettings.dt / temporalSettings.substeps;
+		const DragTerms drag = dragTerms(physicsSettings.dragSettings, substepDuration(temporalSettings));
+		const PositionScalar floorHeight = tissu.tissuSettings.floorHeight;
+		const int count = static_cast<int>(tissu.positions.size());
+
+		tissu.pullPreciseState();
+		Tissu::VerletState<PositionScalar>& state = tissu.preciseState;
+		std::vector<ForceVec> accelerations(count);
+
+		// -------------------------------------------------------------------------------------
+		for (int s = 0; s < temporalSettings.substeps; ++s) {
+			// L'auto-collision travaille sur les buffers float : les points qu'elle deplace sont repris dans l'etat double
+			if (selfCollisionSettings.isEnabled) {
+				tissu.pushPreciseState();
+				handleSelfCollisions(tissu, selfCollisionSettings);
+				tissu.pullPreciseState();
+			}
+
+			// Tension
+			std::fill(accelerations.begin(), accelerations.end(), ForceVec(0));
+			if (tensionSettings.isEnabled) {
+				applyGridStencilPrecise(GridStencil::Structural{}, tissu, state, tensionSettings, accelerations);
+				if (tensionSettings.shear.isEnabled)
+					applyGridStencilPrecise(GridStencil::Shear{}, tissu, state, shearSettings, accelerations);
+				if (tensionSettings.bending.isEnabled)
+					applyGridStencilPrecise(GridStencil::Bending{}, tissu, state, bendingSettings, accelerations);
+			}
+			// Vent par triangle : vitesses relatives calculees sur l'etat double
+			if (isTriangleWind)
+				calculForceWindTriangles(tissu, state.positions, state.positionsOld, windSettings, substepDuration(temporalSettings), simulationTime, accelerations);
+
+			// Forces par point et Verlet (un seul parcours, comme le substep fusionne)
+			#pragma omp parallel for
+			for (int i = 0; i < count; i++) {
+				const PositionVec position = state.positions[i];
+				const PositionVec vitesse = state.vitesse(i);
+				const glm::vec3 positionF(position);
+				const glm::vec3 vitesseF(vitesse);
+				const float invMass = tissu.invMasses[i];
+				ForceVec acceleration = accelerations[i]; // Force, multipliee par invMass dans Verlet
+
+				// Gravité
+				if (gravitySettings.isEnabled && position.z >= floorHeight && (tissu.vertexFlags[i] & Tissu::VERTEX_GRAVITY))
+					acceleration += gravity * static_cast<ForceScalar>(tissu.masses[i]);
+
+				// Wind
+				if (isVertexWind) {
+					float surfaceFactor = glm::clamp(glm::dot(tissu.normals[i], windDirection), 0.0f, 1.0f);
+					acceleration += ForceVec(windBase * surfaceFactor * windVariation);
+				}
+
+				// Collision
+				for (const ColliderShape& collider : colliders)
+					acceleration += ForceVec(colliderForce(collider, positionF, vitesseF, collisionSettings));
+
+				// Grab
+				if (i == grabbedIndex)
+					acceleration += ForceVec((tissu.grabTarget - positionF) * grabSettings.force - grabSettings.damping * vitesseF);
+
+				// Verlet
+				state.positionsNew[i] = verletStep(tissu, i, position, drag.apply(vitesse, invMass), PositionVec(acceleration), dt2, floorHeight);
+			}
+
+			state.updateVertexPosition();
+		}
+
+		tissu.pushPreciseState();
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Substeps adaptatifs (Verlet)
+	// Le temps simule par frame reste celui de temporal : dt * sqrt(substeps). Avec S substeps adaptatifs,
+	// un substep dure (dt * sqrt(substeps)) / S. Trois criteres bornent cette duree h :
+	//   - vitesse       : un point ne parcourt pas plus de cflNumber * longueur a vide par substep
+	//   - deformation   : la deformation d'un ressort ne varie pas de plus de maxStrainPerSubstep par substep
+	//   - penetration   : la reponse d'un objet (raideur * profondeur) ne deplace pas un point de plus que le critere vitesse
+	// Le nombre de substeps monte tout de suite. Il ne redescend que 30 frames apres la derniere montee,
+	// avec 25 % de marge et d'un quart par frame au plus (la deformation mesuree depend elle-meme du nombre de substeps).
+	int estimateAdaptiveSubsteps(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, int previousSubsteps)
+	{
+		constexpr int decreaseDelayFrames = 30; // Apres une montee, on attend ce nombre de frames avant de redescendre
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		const AdaptiveSubstepSettings& adaptiveSettings = temporalSettings.adaptive;
+		const CollisionSettings& collisionSettings = physicsSettings.collisionSettings;
+		const float frameDuration = temporalSettings.dt * std::sqrt(static_cast<float>(temporalSettings.substeps));
+		const float previousDuration = frameDuration / previousSubsteps;
+		const float maxDisplacement = adaptiveSettings.cflNumber * std::min(tissu.tissuSettings.gapPointStartX, tissu.tissuSettings.gapPointStartY);
+		const int count = static_cast<int>(tissu.positions.size());
+		const int edgeCount = static_cast<int>(tissu.springEdgeA.size());
+
+		std::vector<ColliderShape> colliders;
+		if (collisionSettings.isEnabled)
+			colliders = buildColliderShapes(listObj, collisionSettings);
+
+		// Maximums (reduction max a la main : OpenMP 2.0 sous MSVC)
+		float maxSpeed = 0.0f;
+		float maxStrainRate = 0.0f;
+		float maxCollisionAcceleration = 0.0f;
+		#pragma omp parallel
+		{
+			float localSpeed = 0.0f;
+			float localStrainRate = 0.0f;
+			float localCollision = 0.0f;
+
+			#pragma omp for nowait
+			for (int i = 0; i < count; i++) {
+				if (tissu.isFixed(i))
+					continue;
+				localSpeed = std::max(localSpeed, glm::length(tissu.vitesse(i)));
+				for (const ColliderShape& collider : colliders)
+					localCollision = std::max(localCollision, glm::length(colliderForce(collider, tissu.positions[i], glm::vec3(0.0f), collisionSettings)) * tissu.invMasses[i]);
+			}
+			#pragma omp for nowait
+			for (int e = 0; e < edgeCount; e++) {
+				const uint32_t a = tissu.springEdgeA[e];
+				const uint32_t b = tissu.springEdgeB[e];
+				glm::vec3 d = tissu.positions[b] - tissu.positions[a];
+				float length = glm::length(d);
+				if (length > 1e-6f)
+					localStrainRate = std::max(localStrainRate, std::abs(glm::dot(tissu.vitesse(b) - tissu.vitesse(a), d)) / (length * tissu.springEdgeRestLengths[e]));
+			}
+
+			#pragma omp critical
+			{
+				maxSpeed = std::max(maxSpeed, localSpeed / previousDuration);
+				maxStrainRate = std::max(maxStrainRate, localStrainRate / previousDuration);
+				maxCollisionAcceleration = std::max(maxCollisionAcceleration, localCollision);
+			}
+		}
+
+		float substepDuration = frameDuration;
+		if (maxSpeed > 0.0f)
+			substepDuration = std::min(substepDuration, maxDisplacement / maxSpeed);
+		if (maxStrainRate > 0.0f)
+			substepDuration = std::min(substepDuration, adaptiveSettings.maxStrainPerSubstep / maxStrainRate);
+		if (maxCollisionAcceleration > 0.0f)
+			substepDuration = std::min(substepDuration, std::sqrt(maxDisplacement / maxCollisionAcceleration));
+
+		const float needed = frameDuration / substepDuration;
+		int substeps = static_cast<int>(std::ceil(needed));
+		if (substeps > previousSubsteps) {
+			tissu.adaptiveDecreaseDelay = decreaseDelayFrames;
+		}
+		else if (tissu.adaptiveDecreaseDelay > 0) {
+			tissu.adaptiveDecreaseDelay--;
+			substeps = previousSubsteps;
+		}
+		else if (substeps < previousSubsteps) {
+			substeps = static_cast<int>(std::ceil(needed * 1.25f)); // 25 % de marge en descendant
+			substeps = std::min(previousSubsteps, std::max(substeps, previousSubsteps - std::max(1, previousSubsteps / 4)));
+		}
+		return std::clamp(substeps, std::max(1, adaptiveSettings.minSubsteps), std::max(adaptiveSettings.minSubsteps, adaptiveSettings.maxSubsteps));
+	}
+
+	// Une frame avec les substeps de temporal, selon l'integrateur et le chemin choisis
+	void physicCalculationFrame(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime) {
+		// Les tuiles endormies ne sont connues que du chemin classique (applicationForces)
+		const bool isSleeping = canUseSleeping(physicsSettings);
+		if (!isSleeping)
+			tissu.sleepTiles.clear();
+		tissu.substepPipelineIndex = -1; // Choisi plus bas pour les chemins classique et fusionne
+		tissu.simdKernels = nullptr;     // Choisi par physicCalculationSubstepedSimd
+		// L'etat double n'existe qu'en Verlet avec une precision double ou mixte
+		const Precision precision = physicsSettings.precisionSettings.mode;
+		const bool isPrecise = precision != Precision::FLOAT && physicsSettings.temporalSettings.integrator == Integrator::VERLET;
+		if (!isPrecise)
+			tissu.preciseState.clear();
+
+		if (physicsSettings.temporalSettings.integrator == Integrator::IMPLICIT_EULER) {
+			physicCalculationImplicit(tissu, listObj, physicsSettings, simulationTime);
+			return;
+		}
+		if (physicsSettings.temporalSettings.integrator == Integrator::XPBD) {
+			physicCalculationXpbd(tissu, listObj, physicsSettings, simulationTime);
+			return;
+		}
+		if (physicsSettings.temporalSettings.integrator == Integrator::PROJECTIVE) {
+			physicCalculationProjective(tissu, listObj, physicsSettings, simulationTime);
+			return;
+		}
+		if (isPrecise) {
+			if (precision == Precision::DOUBLE)
+				physicCalculationPrecise<double>(tissu, listObj, physicsSettings, simulationTime);
+			else
+				physicCalculationPrecise<float>(tissu, listObj, physicsSettings, simulationTime);
+			return;
+		}
+		// Les chemins SIMD et fusionne calculent les voisins en x * resolutionY + y
+		const bool isRowMajor = tissu.tissuSettings.ordering == Tissu::VertexOrdering::ROW_MAJOR;
+		if (!isSleeping && isRowMajor && physicsSettings.simdSettings.isEnabled && canUseSimdKernels(listObj, physicsSettings)) {
+			physicCalculationSubstepedSimd(tissu, listObj, physicsSettings, simulationTime);
+			return;
+		}
+		// Objets ranges par type et instanciation du substep, une fois par frame
+		const ColliderGroups colliders = buildColliderGroups(listObj, physicsSettings.collisionSettings);
+		if (isSleeping) {
+			for (int s = 0; s < physicsSettings.temporalSettings.substeps; ++s)
+				applicationForcesAwakeTiles(tissu, colliders, physicsSettings, simulationTime);
+			return;
+		}
+		tissu.substepPipelineIndex = selectSubstepPipeline(physicsSettings, colliders);
+		// Le chemin fusionne ne connait que les ressorts structurels et le vent par point
+		const bool isVertexWind = !physicsSettings.windSettings.isEnabled || physicsSettings.windSettings.model == WindModel::VERTEX;
+		if (isRowMajor && isVertexWind && physicsSettings.fusedSettings.isEnabled && !physicsSettings.tensionSettings.shear.isEnabled && !physicsSettings.tensionSettings.bending.isEnabled) {
+			fusedSubstepTable[tissu.substepPipelineIndex](tissu, colliders, physicsSettings, simulationTime);
+			return;
+		}
 		for (int s = 0; s < physicsSettings.temporalSettings.substeps; ++s) {
-			applicationForces(tissu, listObj, physicsSettings);
+			classicSubstepTable[tissu.substepPipelineIndex](tissu, colliders, physicsSettings, simulationTime);
+		}
+	}
+
+	// Main Calculation Substep
+	// simulationTime : horloge de la simulation en secondes, fournie par l'appelant (glfwGetTime() en mode fenetre, horloge fixe en headless)
+	void physicCalculationSubsteped(Tissu::TissuSoA& tissu, const std::vector<MeshGenerator::MeshGenerator*>& listObj, const PhysicsSettings& physicsSettings, double simulationTime) {
+		const TemporalSettings& temporalSettings = physicsSettings.temporalSettings;
+		if (temporalSettings.adaptive.isEnabled && temporalSettings.integrator == Integrator::VERLET) {
+			// Substeps adaptatifs : la frame est calculee avec dt / substeps choisis pour garder le meme temps simule
+			int previousSubsteps = tissu.adaptiveSubsteps > 0 ? tissu.adaptiveSubsteps : temporalSettings.substeps;
+			int substeps = estimateAdaptiveSubsteps(tissu, listObj, physicsSettings, previousSubsteps);
+			if (substeps != previousSubsteps)
+				tissu.rescaleVitesses(static_cast<float>(previousSubsteps) / static_cast<float>(substeps));
+			tissu.adaptiveSubsteps = substeps;
+
+			PhysicsSettings adaptiveSettings = physicsSettings;
+			adaptiveSettings.temporalSettings.dt = temporalSettings.dt * std::sqrt(static_cast<float>(temporalSettings.substeps)) / std::sqrt(static_cast<float>(substeps));
+			adaptiveSettings.temporalSettings.substeps = substeps;
+			// Les amortissements multiplient vitesse(), un deplacement par substep : on les ramene a la duree de substep
+			// de reference pour que la frame simule la meme physique quel que soit le nombre de substeps
+			const float dampingScale = static_cast<float>(substeps) / static_cast<float>(temporalSettings.substeps);
+			adaptiveSettings.tensionSettings.damping *= dampingScale;
+			adaptiveSettings.collisionSettings.damping *= dampingScale;
+			adaptiveSettings.grabSettings.damping *= dampingScale;
+			physicCalculationFrame(tissu, listObj, adaptiveSettings, simulationTime);
+			return;
+		}
+		// Sortie du mode adaptatif : vitesse() reprend la duree de substep de temporal
+		if (tissu.adaptiveSubsteps > 0) {
+			if (tissu.adaptiveSubsteps != temporalSettings.substeps)
+				tissu.rescaleVitesses(static_cast<float>(tissu.adaptiveSubsteps) / static_cast<float>(temporalSettings.substeps));
+			tissu.adaptiveSubsteps = 0;
 		}
+		physicCalculationFrame(tissu, listObj, physicsSettings, simulationTime);
 	}
 }
 #endif
@@ -0,0 +1,295 @@
+#ifndef PROJECTIVE_SOLVER_H
+#define PROJECTIVE_SOLVER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+// ----------------------------------------------------------------------------------------------------
+// Cholesky creux pour Projective Dynamics
+// La matrice globale de Projective Dynamics ne depend que de la topologie, des raideurs, du pas de temps et des
+// points fixes : elle est factorisee une fois puis chaque iteration ne coute qu'une descente / remontee.
+// Elle est scalaire (la meme pour x, y et z) : on resout les trois composantes d'un coup.
+//
+// 1. Renumerotation par dissection emboitee de la grille (separateurs en dernier) pour limiter le remplissage :
+//    O(n log n) entrees dans L au lieu de O(n * resolutionY) avec la numerotation x * resolutionY + y.
+// 2. Factorisation symbolique (structure de L par l'arbre d'elimination), une fois par topologie.
+// 3. Factorisation numerique "left-looking", L stocke par colonne (CSC).
+// La matrice a le motif du CSR des ressorts de TissuSoA (springOffsets / springNeighbors).
+
+namespace ProjectiveSolver
+{
+	// ------------------------------------------------------------------------------------------------
+	// Dissection emboitee geometrique d'une grille (indice = x * resolutionY + y)
+	// reach : ecart max en x ou en y entre deux points relies (1 pour les ressorts structurels)
+	inline void appendNestedDissection(std::vector<uint32_t>& order, size_t resolutionY, size_t reach,
+		size_t x0, size_t x1, size_t y0, size_t y1)
+	{
+		const size_t sizeX = x1 - x0;
+		const size_t sizeY = y1 - y0;
+		const size_t leafSize = 64;
+		if (sizeX * sizeY <= leafSize || (sizeX <= 2 * reach && sizeY <= 2 * reach)) {
+			for (size_t x = x0; x < x1; x++)
+				for (size_t y = y0; y < y1; y++)
+					order.push_back(static_cast<uint32_t>(x * resolutionY + y));
+			return;
+		}
+
+		// Coupe la plus grande dimension par une bande de largeur reach : les deux moities ne sont plus reliees
+		if (sizeX >= sizeY && sizeX > 2 * reach) {
+			size_t mid = x0 + (sizeX - reach) / 2;
+			appendNestedDissection(order, resolutionY, reach, x0, mid, y0, y1);
+			appendNestedDissection(order, resolutionY, reach, mid + reach, x1, y0, y1);
+			appendNestedDissection(order, resolutionY, reach, mid, mid + reach, y0, y1);
+		}
+		else {
+			size_t mid = y0 + (sizeY - reach) / 2;
+			appendNestedDissection(order, resolutionY, reach, x0, x1, y0, mid);
+			appendNestedDissection(order, resolutionY, reach, x0, x1, mid + reach, y1);
+			appendNestedDissection(order, resolutionY, reach, x0, x1, mid, mid + reach);
+		}
+	}
+
+	// order[nouvel indice] = ancien indice
+	inline std::vector<uint32_t> nestedDissectionOrder(size_t resolutionX, size_t resolutionY, size_t reach)
+	{
+		std::vector<uint32_t> order;
+		order.reserve(resolutionX * resolutionY);
+		appendNestedDissection(order, resolutionY, std::max<size_t>(reach, 1), 0, resolutionX, 0, resolutionY);
+		return order;
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	struct SparseCholesky {
+		size_t count = 0;
+		std::vector<uint32_t> order;       // order[nouvel indice] = ancien indice
+		std::vector<uint32_t> rank;        // rank[ancien indice] = nouvel indice
+
+		// L par colonne (nouveaux indices) : colonne j = [columnOffsets[j], columnOffsets[j + 1]), diagonale en premier
+		std::vector<size_t> columnOffsets;
+		std::vector<uint32_t> rowIndices;
+		std::vector<float> values;
+
+		// Factorisation symbolique. offsets / neighbors : motif symetrique de A en anciens indices (sans la diagonale)
+		void analyze(const std::vector<uint32_t>& newOrder, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& neighbors)
+		{
+			count = newOrder.size();
+			order = newOrder;
+			rank.assign(count, 0);
+			for (size_t j = 0; j < count; j++)
+				rank[order[j]] = static_cast<uint32_t>(j);
+
+			// Structure de la colonne j de L = structure de A(j+1:, j) + structures des enfants de j dans l'arbre d'elimination
+			// (le parent d'une colonne est sa premiere ligne sous la diagonale)
+			std::vector<std::vector<uint32_t>> children(count);
+			std::vector<std::vector<uint32_t>> pattern(count);
+			std::vector<uint32_t> marker(count, UINT32_MAX);
+			columnOffsets.assign(count + 1, 0);
+			rowIndices.clear();
+
+			for (size_t j = 0; j < count; j++) {
+				std::vector<uint32_t>& rows = pattern[j];
+				const uint32_t oldJ = order[j];
+				for (uint32_t k = offsets[oldJ]; k < offsets[oldJ + 1]; k++) {
+					uint32_t row = rank[neighbors[k]];
+					if (row > j && marker[row] != j) {
+						marker[row] = static_cast<uint32_t>(j);
+						rows.push_back(row);
+					}
+				}
+				for (uint32_t child : children[j]) {
+					for (uint32_t row : pattern[child])
+						if (row > j && marker[row] != j) {
+							marker[row] = static_cast<uint32_t>(j);
+							rows.push_back(row);
+						}
+					std::vector<uint32_t>().swap(pattern[child]); // Contenue dans celle de j, plus utile
+				}
+				std::vector<uint32_t>().swap(children[j]);
+				std::sort(rows.begin(), rows.end());
+				if (!rows.empty())
+					children[rows.front()].push_back(static_cast<uint32_t>(j));
+
+				rowIndices.push_back(static_cast<uint32_t>(j));
+				rowIndices.insert(rowIndices.end(), rows.begin(), rows.end());
+				columnOffsets[j + 1] = rowIndices.size();
+			}
+
+			values.assign(rowIndices.size(), 0.0f);
+			work.assign(count, 0.0f);
+			head.assign(count, UINT32_MAX);
+			next.assign(count, UINT32_MAX);
+			cursor.assign(count, 0);
+		}
+
+		// Factorisation numerique (apres analyze). A en anciens indices :
+		// A(i, i) = diagonal[i], A(i, neighbors[k]) = offDiagonal[k] pour k dans [offsets[i], offsets[i + 1])
+		// Retourne false si un pivot n'est pas positif (matrice non definie positive)
+		bool factorize(const std::vector<float>& diagonal, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& neighbors, const std::vector<float>& offDiagonal)
+		{
+			// Colonnes k < j ayant une entree en ligne j : liste chainee head[j] -> next[k], cursor[k] = position de cette entree
+			std::fill(head.begin(), head.end(), UINT32_MAX);
+
+			for (size_t j = 0; j < count; j++) {
+				const size_t begin = columnOffsets[j];
+				const size_t end = columnOffsets[j + 1];
+
+				// Colonne j de A (sous la diagonale) dans la colonne dense de travail
+				const uint32_t oldJ = order[j];
+				double pivot = diagonal[oldJ];
+				for (uint32_t k = offsets[oldJ]; k < offsets[oldJ + 1]; k++) {
+					uint32_t row = rank[neighbors[k]];
+					if (row > j)
+						work[row] += offDiagonal[k];
+				}
+
+				// Contribution de chaque colonne k telle que L(j, k) != 0
+				uint32_t k = head[j];
+				while (k != UINT32_MAX) {
+					const uint32_t nextK = next[k];
+					const size_t p = cursor[k];
+					const size_t endK = columnOffsets[k + 1];
+					const float ljk = values[p];
+					pivot -= static_cast<double>(ljk) * ljk;
+					for (size_t q = p + 1; q < endK; q++)
+						work[rowIndices[q]] -= values[q] * ljk;
+					if (p + 1 < endK) {
+						cursor[k] = p + 1;
+						const uint32_t row = rowIndices[p + 1];
+						next[k] = head[row];
+						head[row] = k;
+					}
+					k = nextK;
+				}
+
+				if (!(pivot > 0.0))
+					return false;
+				const float ljj = static_cast<float>(std::sqrt(pivot));
+				const float inverse = 1.0f / ljj;
+				values[begin] = ljj;
+				// Le remplissage decroit tres vite (I / h^2 domine) : les valeurs sous-normales sont mises a zero,
+				// sinon descente et remontee passent la plupart de leur temps dans l'arithmetique denormalisee
+				for (size_t q = begin + 1; q < end; q++) {
+					const float value = work[rowIndices[q]] * inverse;
+					values[q] = std::abs(value) < std::numeric_limits<float>::min() ? 0.0f : value;
+					work[rowIndices[q]] = 0.0f;
+				}
+
+				if (begin + 1 < end) {
+					cursor[j] = begin + 1;
+					const uint32_t row = rowIndices[begin + 1];
+					next[j] = head[row];
+					head[row] = static_cast<uint32_t>(j);
+				}
+			}
+
+			// Copie compacte de L pour les resolutions : sans les entrees trop petites pour changer un resultat en float
+			// (|L(i, j)| <= 1e-7 L(j, j)), soit la grande majorite du remplissage pour un tissu souple
+			solveOffsets.assign(count + 1, 0);
+			solveRows.clear();
+			solveValues.clear();
+			inverseDiagonal.resize(count);
+			for (size_t j = 0; j < count; j++) {
+				const size_t begin = columnOffsets[j];
+				const float threshold = 1e-7f * values[begin];
+				inverseDiagonal[j] = 1.0f / values[begin];
+				for (size_t q = begin + 1; q < columnOffsets[j + 1]; q++)
+					if (std::abs(values[q]) > threshold) {
+						solveRows.push_back(rowIndices[q]);
+						solveValues.push_back(values[q]);
+					}
+				solveOffsets[j + 1] = solveRows.size();
+			}
+			return true;
+		}
+
+		// Resout A x = b en place (b en entree, x en sortie, anciens indices)
+		// Les composantes sont separees (et renumerotees) le temps de la resolution
+		void solve(std::vector<glm::vec3>& b)
+		{
+			bx.resize(count);
+			by.resize(count);
+			bz.resize(count);
+			for (size_t j = 0; j < count; j++) {
+				const glm::vec3 value = b[order[j]];
+				bx[j] = value.x;
+				by[j] = value.y;
+				bz[j] = value.z;
+			}
+
+			// L y = b, par colonne
+			for (size_t j = 0; j < count; j++) {
+				const float yx = bx[j] * inverseDiagonal[j];
+				const float yy = by[j] * inverseDiagonal[j];
+				const float yz = bz[j] * inverseDiagonal[j];
+				bx[j] = yx;
+				by[j] = yy;
+				bz[j] = yz;
+				for (size_t q = solveOffsets[j]; q < solveOffsets[j + 1]; q++) {
+					const uint32_t row = solveRows[q];
+					bx[row] -= solveValues[q] * yx;
+					by[row] -= solveValues[q] * yy;
+					bz[row] -= solveValues[q] * yz;
+				}
+			}
+			// L^T x = y (la colonne j de L est la ligne j de L^T)
+			for (size_t j = count; j-- > 0;) {
+				float sx = bx[j], sy = by[j], sz = bz[j];
+				for (size_t q = solveOffsets[j]; q < solveOffsets[j + 1]; q++) {
+					const uint32_t row = solveRows[q];
+					sx -= solveValues[q] * bx[row];
+					sy -= solveValues[q] * by[row];
+					sz -= solveValues[q] * bz[row];
+				}
+				bx[j] = sx * inverseDiagonal[j];
+				by[j] = sy * inverseDiagonal[j];
+				bz[j] = sz * inverseDiagonal[j];
+			}
+
+			for (size_t j = 0; j < count; j++)
+				b[order[j]] = glm::vec3(bx[j], by[j], bz[j]);
+		}
+
+	private:
+		// Travail de factorize
+		std::vector<float> work;           // Colonne dense (remise a zero apres chaque colonne)
+		std::vector<uint32_t> head;
+		std::vector<uint32_t> next;
+		std::vector<size_t> cursor;
+		// L compacte pour solve (hors diagonale, meme organisation par colonne)
+		std::vector<size_t> solveOffsets;
+		std::vector<uint32_t> solveRows;
+		std::vector<float> solveValues;
+		std::vector<float> inverseDiagonal;
+		// Travail de solve
+		std::vector<float> bx, by, bz;
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Matrice factorisee + ce qui a servi a la construire : on refactorise seulement si l'un d'eux change
+	struct Factorization {
+		SparseCholesky cholesky;
+		bool isAnalyzed = false;           // Structure de L (ne depend que de la topologie)
+		bool isValid = false;
+		float stepDuration = 0.0f;
+		float stiffness = 0.0f;
+		size_t springCount = 0;
+		std::vector<float> invMasses;      // TissuSoA::invMasses a la factorisation (masses et points fixes)
+
+		// Valeurs de A (motif du CSR des ressorts)
+		std::vector<float> diagonal;
+		std::vector<float> offDiagonal;
+
+		// Vecteurs de travail
+		std::vector<glm::vec3> inertia;    // s = x + h v + h^2 a
+		std::vector<glm::vec3> rhs;        // Second membre, puis solution
+
+		int factorizationCount = 0;        // Nombre de factorisations numeriques depuis le debut
+	};
+}
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <omp.h>
+
+#include "tissuSoA.h"
+#include "physicSoA.h"
+#include "mesh_generator.h"
+
+// ----------------------------------------------------------------------------------------------------
+// Scene : plusieurs tissus (drapeaux, rideaux...) calcules dans le meme processus, chacun avec ses reglages
+// Les tissus sont independants : seuls les objets de collision sont partages.
+//
+// Repartition sur les threads (voir forEachCloth) :
+//  - un gros tissu (plus d'une part de thread du travail total) est calcule seul, avec le parallelisme interne des noyaux ;
+//  - les petits tissus sont distribues, un tissu par thread, dans une boucle dynamique triee du plus cher au moins cher.
+//    Leurs regions paralleles internes deviennent imbriquees, donc inactives (equipe d'un seul thread) :
+//    pas de synchronisation par substep sur quelques centaines de points, et aucun coeur n'attend la fin d'un petit tissu.
+
+namespace Scene
+{
+	struct ClothSettings {
+		std::string name = "tissu";
+		Tissu::TissuSettings tissuSettings;
+		Physics::PhysicsSettings physicsSettings;
+		bool lockCorner = true;
+	};
+
+	struct SceneSettings {
+		std::vector<ClothSettings> cloths;
+		// En dessous de ce nombre de points, un tissu n'est jamais decoupe entre plusieurs threads
+		int minVerticesForInnerParallel = 4096;
+	};
+
+	struct Cloth {
+		std::string name;
+		std::unique_ptr<Tissu::TissuSoA> tissu; // Adresse stable : la console, le grab et le rendu gardent des references
+		Physics::PhysicsSettings physicsSettings;
+	};
+
+	class Scene
+	{
+	public:
+		// ------------------------------------------------------------------------------------------------
+		// Attributes
+		std::vector<Cloth> cloths;
+		int minVerticesForInnerParallel = 4096;
+
+		// ------------------------------------------------------------------------------------------------
+		// Constructor
+		Scene(const SceneSettings& sceneSettings) : minVerticesForInnerParallel(sceneSettings.minVerticesForInnerParallel)
+		{
+			cloths.reserve(sceneSettings.cloths.size());
+			for (const ClothSettings& clothSettings : sceneSettings.cloths)
+				addCloth(clothSettings);
+		}
+
+		Cloth& addCloth(const ClothSettings& clothSettings)
+		{
+			Cloth cloth;
+			cloth.name = clothSettings.name;
+			cloth.tissu = std::make_unique<Tissu::TissuSoA>(clothSettings.tissuSettings);
+			cloth.tissu->lockCorner(clothSettings.lockCorner);
+			cloth.physicsSettings = clothSettings.physicsSettings;
+			cloths.push_back(std::move(cloth));
+			return cloths.back();
+		}
+
+		size_t vertexCount() const
+		{
+			size_t count = 0;
+			for (const Cloth& cloth : cloths)
+				count += cloth.tissu->positions.size();
+			return count;
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Calculs par tissu
+
+		void physicCalculationSubsteped(const std::vector<MeshGenerator::MeshGenerator*>& listObj, double simulationTime)
+		{
+			// Cout d'une frame ~ points x substeps (les integrateurs implicites ont un cout par point du meme ordre)
+			std::vector<double> costs(cloths.size());
+			for (size_t c = 0; c < cloths.size(); c++) {
+				const Physics::TemporalSettings& temporalSettings = cloths[c].physicsSettings.temporalSettings;
+				int substeps = cloths[c].tissu->adaptiveSubsteps > 0 ? cloths[c].tissu->adaptiveSubsteps : temporalSettings.substeps;
+				costs[c] = static_cast<double>(cloths[c].tissu->positions.size()) * std::max(substeps, 1);
+			}
+			forEachCloth(costs, [&](Cloth& cloth) {
+				Physics::physicCalculationSubsteped(*cloth.tissu, listObj, cloth.physicsSettings, simulationTime);
+			});
+			// Journal apres la boucle parallele, un tissu apres l'autre
+			for (Cloth& cloth : cloths)
+				Physics::reportFrameChoices(*cloth.tissu, cloths.size() > 1 ? cloth.name + ": " : std::string());
+		}
+
+		void calculationNormals()
+		{
+			forEachCloth(vertexCosts(), [](Cloth& cloth) { cloth.tissu->calculationNormals(); });
+		}
+
+		void generateVBOBuffers()
+		{
+			forEachCloth(vertexCosts(), [](Cloth& cloth) { cloth.tissu->generateVBOBuffer(); });
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Ordonnancement
+		// OpenMP 2.0 (MSVC) n'a pas de taches : la boucle schedule(dynamic, 1) sur les tissus tries par cout decroissant
+		// joue le meme role (chaque thread libre prend le plus gros tissu restant).
+		template<typename Function>
+		void forEachCloth(const std::vector<double>& costs, Function&& function)
+		{
+			const int threadCount = omp_get_max_threads();
+			const double totalCost = std::accumulate(costs.begin(), costs.end(), 0.0);
+
+			std::vector<int> wideCloths;   // Calcules l'un apres l'autre, parallelisme interne
+			std::vector<int> narrowCloths; // Un thread par tissu
+			for (int c = 0; c < static_cast<int>(cloths.size()); c++) {
+				bool isWide = threadCount > 1
+					&& static_cast<int>(cloths[c].tissu->positions.size()) >= minVerticesForInnerParallel
+					&& costs[c] * threadCount >= totalCost;
+				(isWide ? wideCloths : narrowCloths).push_back(c);
+			}
+
+			for (int c : wideCloths)
+				function(cloths[c]);
+
+			if (narrowCloths.size() == 1) {
+				function(cloths[narrowCloths[0]]);
+				return;
+			}
+			std::sort(narrowCloths.begin(), narrowCloths.end(), [&](int a, int b) { return costs[a] > costs[b]; });
+
+			#pragma omp parallel for schedule(dynamic, 1)
+			for (int k = 0; k < static_cast<int>(narrowCloths.size()); k++)
+				function(cloths[narrowCloths[k]]);
+		}
+
+	private:
+		std::vector<double> vertexCosts() const
+		{
+			std::vector<double> costs(cloths.size());
+			for (size_t c = 0; c < cloths.size(); c++)
+				costs[c] = static_cast<double>(cloths[c].tissu->positions.size());
+			return costs;
+		}
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Objets de collision de la scene (sphere et boite), places par rapport au centre du premier tissu
+	// Construits ici pour la version fenetree et pour drap_headless : une meme config donne la meme scene dans les deux
+	struct Colliders {
+		std::unique_ptr<MeshGenerator::MeshGenerator> sphere;
+		std::unique_ptr<MeshGenerator::MeshGenerator> box;
+		std::vector<MeshGenerator::MeshGenerator*> collidables; // Objets actives dans la config (activateSphere, activateBox)
+	};
+
+	inline Colliders createColliders(const Tissu::TissuSoA& reference, bool isSphereActive, bool isBoxActive)
+	{
+		const Tissu::TissuSettings& settings = reference.tissuSettings;
+		const glm::vec3 tissuCenter = settings.positionOrigin + glm::vec3(((settings.resolutionX - 1) * settings.gapPointStartX) / 2, ((settings.resolutionY - 1) * settings.gapPointStartY) / 2, 0.0f);
+		Colliders colliders;
+
+		MeshGenerator::MeshSettings sphereSettings;
+		sphereSettings.position = tissuCenter + glm::vec3(1.7f, 0.0f, -2.5f);
+		sphereSettings.radius = 2.7f;
+		sphereSettings.resolutionX = 20;
+		sphereSettings.resolutionY = 20;
+		sphereSettings.rotationAxis = glm::vec3(1.0f, 1.0f, 1.0f);
+		colliders.sphere = MeshGenerator::MeshFactory::createMesh(MeshGenerator::PrimitiveType::SPHERE, sphereSettings);
+		if (isSphereActive)
+			colliders.collidables.emplace_back(colliders.sphere.get());
+
+		MeshGenerator::MeshSettings boxSettings;
+		boxSettings.size = glm::vec3(2.0f, 4.0f, 2.0f);
+		boxSettings.position = tissuCenter + glm::vec3(-1.7f, 0.0f, -1.2f);
+		boxSettings.resolutionX = 4;
+		boxSettings.resolutionY = 4;
+		boxSettings.resolutionZ = 4;
+		colliders.box = MeshGenerator::MeshFactory::createMesh(MeshGenerator::PrimitiveType::BOX, boxSettings);
+		if (isBoxActive)
+			colliders.collidables.emplace_back(colliders.box.get());
+
+		return colliders;
+	}
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include <immintrin.h>
+#include "simd_kernels_impl.h"
+
+// ----------------------------------------------------------------------------------------------------
+// Noyaux AVX2 + FMA (8 floats par registre). Compile avec -mavx2 -mfma / arch:AVX2 (voir CMakeLists.txt),
+// appele seulement si detectInstructionSet() l'autorise.
+
+namespace
+{
+	struct Avx2Vec {
+		static constexpr int width = 8;
+		struct Mask { __m256 m; };
+		__m256 v;
+
+		static Avx2Vec load(const float* p) { return { _mm256_load_ps(p) }; }
+		static Avx2Vec loadu(const float* p) { return { _mm256_loadu_ps(p) }; }
+		static Avx2Vec set1(float f) { return { _mm256_set1_ps(f) }; }
+		void store(float* p) const { _mm256_store_ps(p, v); }
+		void storeu(float* p) const { _mm256_storeu_ps(p, v); }
+
+		friend Avx2Vec operator+(Avx2Vec a, Avx2Vec b) { return { _mm256_add_ps(a.v, b.v) }; }
+		friend Avx2Vec operator-(Avx2Vec a, Avx2Vec b) { return { _mm256_sub_ps(a.v, b.v) }; }
+		friend Avx2Vec operator*(Avx2Vec a, Avx2Vec b) { return { _mm256_mul_ps(a.v, b.v) }; }
+		friend Avx2Vec operator/(Avx2Vec a, Avx2Vec b) { return { _mm256_div_ps(a.v, b.v) }; }
+		friend Avx2Vec fmadd(Avx2Vec a, Avx2Vec b, Avx2Vec c) { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+		friend Avx2Vec sqrt(Avx2Vec a) { return { _mm256_sqrt_ps(a.v) }; }
+		friend Avx2Vec min(Avx2Vec a, Avx2Vec b) { return { _mm256_min_ps(a.v, b.v) }; }
+		friend Avx2Vec max(Avx2Vec a, Avx2Vec b) { return { _mm256_max_ps(a.v, b.v) }; }
+		friend Avx2Vec abs(Avx2Vec a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+
+		friend Mask lt(Avx2Vec a, Avx2Vec b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+		friend Mask le(Avx2Vec a, Avx2Vec b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+		friend Mask gt(Avx2Vec a, Avx2Vec b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+		friend Mask ge(Avx2Vec a, Avx2Vec b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+		friend Mask andMask(Mask a, Mask b) { return { _mm256_and_ps(a.m, b.m) }; }
+		friend Avx2Vec select(Mask m, Avx2Vec a, Avx2Vec b) { return { _mm256_blendv_ps(b.v, a.v, m.m) }; }
+	};
+}
+
+namespace Simd
+{
+	const KernelTable& avx2Kernels()
+	{
+		static const KernelTable table = Impl::makeKernelTable<Avx2Vec>(InstructionSet::AVX2);
+		return table;
+	}
+}
@@ -0,0 +1,47 @@
+#include <immintrin.h>
+#include "simd_kernels_impl.h"
+
+// ----------------------------------------------------------------------------------------------------
+// Noyaux AVX-512F (16 floats par registre, masques __mmask16). Compile avec -mavx512f / arch:AVX512
+// (voir CMakeLists.txt), appele seulement si detectInstructionSet() l'autorise.
+
+namespace
+{
+	struct Avx512Vec {
+		static constexpr int width = 16;
+		struct Mask { __mmask16 m; };
+		__m512 v;
+
+		static Avx512Vec load(const float* p) { return { _mm512_load_ps(p) }; }
+		static Avx512Vec loadu(const float* p) { return { _mm512_loadu_ps(p) }; }
+		static Avx512Vec set1(float f) { return { _mm512_set1_ps(f) }; }
+		void store(float* p) const { _mm512_store_ps(p, v); }
+		void storeu(float* p) const { _mm512_storeu_ps(p, v); }
+
+		friend Avx512Vec operator+(Avx512Vec a, Avx512Vec b) { return { _mm512_add_ps(a.v, b.v) }; }
+		friend Avx512Vec operator-(Avx512Vec a, Avx512Vec b) { return { _mm512_sub_ps(a.v, b.v) }; }
+		friend Avx512Vec operator*(Avx512Vec a, Avx512Vec b) { return { _mm512_mul_ps(a.v, b.v) }; }
+		friend Avx512Vec operator/(Avx512Vec a, Avx512Vec b) { return { _mm512_div_ps(a.v, b.v) }; }
+		friend Avx512Vec fmadd(Avx512Vec a, Avx512Vec b, Avx512Vec c) { return { _mm512_fmadd_ps(a.v, b.v, c.v) }; }
+		friend Avx512Vec sqrt(Avx512Vec a) { return { _mm512_sqrt_ps(a.v) }; }
+		friend Avx512Vec min(Avx512Vec a, Avx512Vec b) { return { _mm512_min_ps(a.v, b.v) }; }
+		friend Avx512Vec max(Avx512Vec a, Avx512Vec b) { return { _mm512_max_ps(a.v, b.v) }; }
+		friend Avx512Vec abs(Avx512Vec a) { return { _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(0x7FFFFFFF))) }; }
+
+		friend Mask lt(Avx512Vec a, Avx512Vec b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ) }; }
+		friend Mask le(Avx512Vec a, Avx512Vec b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ) }; }
+		friend Mask gt(Avx512Vec a, Avx512Vec b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ) }; }
+		friend Mask ge(Avx512Vec a, Avx512Vec b) { return { _mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ) }; }
+		friend Mask andMask(Mask a, Mask b) { return { static_cast<__mmask16>(a.m & b.m) }; }
+		friend Avx512Vec select(Mask m, Avx512Vec a, Avx512Vec b) { return { _mm512_mask_blend_ps(m.m, b.v, a.v) }; }
+	};
+}
+
+namespace Simd
+{
+	const KernelTable& avx512Kernels()
+	{
+		static const KernelTable table = Impl::makeKernelTable<Avx512Vec>(InstructionSet::AVX512);
+		return table;
+	}
+}
@@ -0,0 +1,269 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// ----------------------------------------------------------------------------------------------------
+// Noyaux SIMD explicites (AVX2 / AVX-512) sur un vrai layout SoA : un tableau de float aligne par composante.
+// Les noyaux sont ecrits une seule fois (simd_kernels_impl.h) puis compiles dans une unite de traduction
+// par jeu d'instructions (simd_scalar.cpp, simd_avx2.cpp, simd_avx512.cpp) avec les bons flags de compilation.
+// Le choix se fait a l'execution selon le CPU (selectKernels).
+//
+// Ce header est inclus par plusieurs unites de traduction : tout ce qui est defini ici est inline.
+
+namespace Simd
+{
+	// ------------------------------------------------------------------------------------------------
+	// Jeux d'instructions
+	enum class InstructionSet {
+		AUTO,
+		SCALAR,
+		AVX2,
+		AVX512,
+	};
+
+	inline const char* toString(InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case InstructionSet::AUTO:   return "auto";
+		case InstructionSet::SCALAR: return "scalar";
+		case InstructionSet::AVX2:   return "avx2";
+		case InstructionSet::AVX512: return "avx512";
+		}
+		return "unknown";
+	}
+
+	inline InstructionSet parseInstructionSet(const std::string& name)
+	{
+		if (name == "scalar") return InstructionSet::SCALAR;
+		if (name == "avx2")   return InstructionSet::AVX2;
+		if (name == "avx512") return InstructionSet::AVX512;
+		if (name != "auto")
+			std::cerr << "ERROR: Simd: Unknown instruction set \"" << name << "\", using auto" << std::endl;
+		return InstructionSet::AUTO;
+	}
+
+	// Meilleur jeu d'instructions supporte par le CPU (et l'OS pour les registres ymm/zmm)
+	inline InstructionSet detectInstructionSet()
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		int info[4];
+		__cpuid(info, 0);
+		int nbIds = info[0];
+		__cpuidex(info, 1, 0);
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		bool fma = (info[2] & (1 << 12)) != 0;
+		if (!osxsave || !avx || nbIds < 7)
+			return InstructionSet::SCALAR;
+		unsigned long long xcr0 = _xgetbv(0);
+		bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+		bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+		__cpuidex(info, 7, 0);
+		bool avx2 = (info[1] & (1 << 5)) != 0;
+		bool avx512f = (info[1] & (1 << 16)) != 0;
+		if (zmmEnabled && avx512f) return InstructionSet::AVX512;
+		if (ymmEnabled && avx2 && fma) return InstructionSet::AVX2;
+		return InstructionSet::SCALAR;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) return InstructionSet::AVX512;
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return InstructionSet::AVX2;
+		return InstructionSet::SCALAR;
+#else
+		return InstructionSet::SCALAR;
+#endif
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Stockage aligne
+	constexpr size_t alignment = 64;     // Une ligne de cache, et la taille d'un registre AVX-512
+	constexpr size_t paddingWidth = 16;  // Largeur max (floats) d'un registre : toutes les tailles sont arrondies a ce multiple
+
+	inline size_t roundUp(size_t n, size_t multiple) { return (n + multiple - 1) / multiple * multiple; }
+
+	template <typename T>
+	struct AlignedAllocator {
+		using value_type = T;
+		AlignedAllocator() = default;
+		template <typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+		T* allocate(size_t n) {
+			void* ptr = ::operator new(roundUp(n * sizeof(T), alignment), std::align_val_t(alignment));
+			return static_cast<T*>(ptr);
+		}
+		void deallocate(T* ptr, size_t) {
+			::operator delete(ptr, std::align_val_t(alignment));
+		}
+		template <typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+		template <typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+	};
+
+	using AlignedFloats = std::vector<float, AlignedAllocator<float>>;
+
+	struct Float3Array {
+		AlignedFloats x;
+		AlignedFloats y;
+		AlignedFloats z;
+
+		void assign(size_t n, float value) {
+			x.assign(n, value);
+			y.assign(n, value);
+			z.assign(n, value);
+		}
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Layout SoA du tissu (grille resolutionX x resolutionY, indice = x * resolutionY + y)
+	// Les tableaux de points font paddedCount + halo floats : le halo (> resolutionY) permet de charger
+	// le voisin (k + 1), (k + resolutionY) ou (k + resolutionY + 1) d'un bloc sans test. Les tableaux de forces de ressort ont le halo
+	// devant (decalage de halo) pour lire F[k - 1] et F[k - resolutionY] sans test non plus.
+	struct SplitLayout {
+		size_t count = 0;
+		size_t paddedCount = 0;
+		size_t halo = 0;
+		size_t resolutionX = 0;
+		size_t resolutionY = 0;
+
+		Float3Array positions;
+		Float3Array velocities;       // Deplacement sur un substep (x(t) - x(t - 1)), meme convention que TissuSoA::vitesse()
+		Float3Array accelerations;    // Forces accumulees, multipliees par invMasses dans verlet
+		Float3Array normals;
+		AlignedFloats invMasses;      // 1 / masse, 0.0f : point fixe
+		AlignedFloats gravityMasses;  // Masse si le point est soumis a la gravite, 0.0f sinon
+		AlignedFloats validSpringX;   // 1.0f si le ressort (k, k + resolutionY) existe
+		AlignedFloats validSpringY;   // 1.0f si le ressort (k, k + 1) existe
+		Float3Array springForceX;     // Force du ressort (k, k + resolutionY), stockee en [halo + k]
+		Float3Array springForceY;     // Force du ressort (k, k + 1), stockee en [halo + k]
+		Float3Array triangleForceA;   // Vent par triangle : force du triangle (k, k + resolutionY + 1, k + 1), stockee en [halo + k]
+		Float3Array triangleForceB;   // Vent par triangle : force du triangle (k, k + resolutionY, k + resolutionY + 1), stockee en [halo + k]
+
+		void resize(size_t resX, size_t resY)
+		{
+			resolutionX = resX;
+			resolutionY = resY;
+			count = resX * resY;
+			paddedCount = roundUp(count, paddingWidth);
+			halo = roundUp(resY + 1, paddingWidth);
+
+			positions.assign(paddedCount + halo, 0.0f);
+			velocities.assign(paddedCount + halo, 0.0f);
+			accelerations.assign(paddedCount, 0.0f);
+			normals.assign(paddedCount, 0.0f);
+			invMasses.assign(paddedCount, 0.0f);
+			gravityMasses.assign(paddedCount, 0.0f);
+			springForceX.assign(halo + paddedCount, 0.0f);
+			springForceY.assign(halo + paddedCount, 0.0f);
+			triangleForceA.assign(halo + paddedCount, 0.0f);
+			triangleForceB.assign(halo + paddedCount, 0.0f);
+
+			validSpringX.assign(paddedCount, 0.0f);
+			validSpringY.assign(paddedCount, 0.0f);
+			for (size_t k = 0; k < count; k++) {
+				validSpringX[k] = (k + resY < count) ? 1.0f : 0.0f;
+				validSpringY[k] = (k % resY != resY - 1) ? 1.0f : 0.0f;
+			}
+		}
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Parametres des noyaux (pre-calcules une fois par frame par l'appelant)
+	struct GravityParams {
+		float accelerationX, accelerationY, accelerationZ; // direction * amplitude (force = acceleration * gravityMasses)
+		float floorHeight;
+	};
+	struct TensionParams {
+		float stiffness;
+		float damping;
+		float maxTensionForce;
+		float restLengthX;
+		float restLengthY;
+	};
+	struct WindParams {
+		float directionX, directionY, directionZ; // normalisee
+		float amplitude;                          // amplitude * variation temporelle
+	};
+	// Vent par triangle : force = dragFactor * |N . v| * v + liftFactor * (N . v) / (|N| |v|) * (|v|^2 * N - (N . v) * v),
+	// avec N = produit vectoriel des aretes (|N| = 2 * aire, le 0.5 est dans les facteurs) et v la vitesse relative de l'air
+	struct AeroWindParams {
+		float airVelocityX, airVelocityY, airVelocityZ; // direction * airSpeed * variation temporelle
+		float velocityScale;                      // 1 / (3 * duree d'un substep) : somme des 3 deplacements -> vitesse moyenne
+		float dragFactor;                         // 0.25 * densite * Cd
+		float liftFactor;                         // 0.25 * densite * Cl
+		float vertexShare;                        // 1 / 3 : un tiers de la force par point
+	};
+	struct SphereParams {
+		float centerX, centerY, centerZ;
+		float radiusWithGap;
+		float stiffness;
+	};
+	struct BoxParams {
+		float centerX, centerY, centerZ;
+		float halfSizeX, halfSizeY, halfSizeZ;
+		float rotation[9];                        // Matrice de rotation, colonne par colonne (comme glm::mat3)
+		float stiffness;
+	};
+	struct VerletParams {
+		float dt2;                                // dt^2 / substeps
+		float floorHeight;
+		float dragLinear;                         // Frottement de l'air (Physics::DragTerms), 0 sans frottement
+		float dragQuadratic;
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Table de noyaux pour un jeu d'instructions
+	struct KernelTable {
+		InstructionSet instructionSet;
+		void (*resetAcceleration)(SplitLayout&);
+		void (*gravity)(SplitLayout&, const GravityParams&);
+		void (*tension)(SplitLayout&, const TensionParams&);
+		void (*wind)(SplitLayout&, const WindParams&);
+		void (*windTriangles)(SplitLayout&, const AeroWindParams&);
+		void (*sphereCollision)(SplitLayout&, const SphereParams&);
+		void (*boxCollision)(SplitLayout&, const BoxParams&);
+		void (*verlet)(SplitLayout&, const VerletParams&);
+	};
+
+	// Definies dans simd_scalar.cpp / simd_avx2.cpp / simd_avx512.cpp
+	const KernelTable& scalarKernels();
+#ifdef DRAP_HAS_X86_SIMD
+	const KernelTable& avx2Kernels();
+	const KernelTable& avx512Kernels();
+#endif
+
+	// Choisit la table demandee si le CPU la supporte, sinon la meilleure disponible
+	inline const KernelTable& selectKernels(InstructionSet requested)
+	{
+#ifdef DRAP_HAS_X86_SIMD
+		static const InstructionSet supported = detectInstructionSet();
+		InstructionSet chosen = requested;
+		if (requested == InstructionSet::AUTO
+			|| (requested == InstructionSet::AVX512 && supported != InstructionSet::AVX512)
+			|| (requested == InstructionSet::AVX2 && supported == InstructionSet::SCALAR))
+			chosen = supported;
+
+		switch (chosen)
+		{
+		case InstructionSet::AVX512: return avx512Kernels();
+		case InstructionSet::AVX2:   return avx2Kernels();
+		default:                     return scalarKernels();
+		}
+#else
+		(void)requested;
+		return scalarKernels();
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,348 @@
+#ifndef SIMD_KERNELS_IMPL_H
+#define SIMD_KERNELS_IMPL_H
+
+#include <cstdint>
+#include <omp.h>
+#include "simd_kernels.h"
+
+// ----------------------------------------------------------------------------------------------------
+// Corps des noyaux SIMD, ecrits une fois pour un type vecteur generique V.
+// Inclus uniquement par simd_scalar.cpp / simd_avx2.cpp / simd_avx512.cpp, qui definissent chacun V
+// dans un namespace anonyme : tout ce qui est ici depend de V, aucune fonction n'est partagee entre
+// des unites de traduction compilees avec des flags differents.
+//
+// V doit fournir : width, Mask, load/loadu/set1/store/storeu, + - * /, fmadd, sqrt, min, max,
+//                  lt/le/gt/ge, andMask, select(mask, siVrai, siFaux)
+
+namespace Simd
+{
+	namespace Impl
+	{
+		// ------------------------------------------------------------------------------------------------
+		// Boucle parallele sur des blocs de V::width floats (n est un multiple de paddingWidth)
+		template <typename V, typename F>
+		void forEachBlock(size_t n, F&& f)
+		{
+			const int64_t nbBlocks = static_cast<int64_t>(n / V::width);
+			#pragma omp parallel for schedule(static)
+			for (int64_t b = 0; b < nbBlocks; b++) {
+				f(static_cast<size_t>(b) * V::width);
+			}
+		}
+
+		template <typename V>
+		struct Vec3 {
+			V x, y, z;
+		};
+
+		template <typename V>
+		Vec3<V> load3(const Float3Array& a, size_t k) {
+			return { V::load(a.x.data() + k), V::load(a.y.data() + k), V::load(a.z.data() + k) };
+		}
+		template <typename V>
+		Vec3<V> loadu3(const Float3Array& a, size_t k) {
+			return { V::loadu(a.x.data() + k), V::loadu(a.y.data() + k), V::loadu(a.z.data() + k) };
+		}
+		template <typename V>
+		void store3(Float3Array& a, size_t k, const Vec3<V>& v) {
+			v.x.store(a.x.data() + k);
+			v.y.store(a.y.data() + k);
+			v.z.store(a.z.data() + k);
+		}
+		template <typename V>
+		void addTo3(Float3Array& a, size_t k, const Vec3<V>& v) {
+			store3(a, k, Vec3<V>{ V::load(a.x.data() + k) + v.x, V::load(a.y.data() + k) + v.y, V::load(a.z.data() + k) + v.z });
+		}
+		template <typename V>
+		V dot3(const Vec3<V>& a, const Vec3<V>& b) {
+			return fmadd(a.x, b.x, fmadd(a.y, b.y, a.z * b.z));
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Remise a zero
+		template <typename V>
+		void resetAcceleration(SplitLayout& layout)
+		{
+			const V zero = V::set1(0.0f);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				store3(layout.accelerations, k, Vec3<V>{ zero, zero, zero });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Gravite
+		template <typename V>
+		void gravity(SplitLayout& layout, const GravityParams& params)
+		{
+			const V gx = V::set1(params.accelerationX);
+			const V gy = V::set1(params.accelerationY);
+			const V gz = V::set1(params.accelerationZ);
+			const V floor = V::set1(params.floorHeight);
+			const V zero = V::set1(0.0f);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				V mask = select(ge(V::load(layout.positions.z.data() + k), floor), V::load(layout.gravityMasses.data() + k), zero);
+				addTo3(layout.accelerations, k, Vec3<V>{ gx * mask, gy * mask, gz * mask });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Tension : meme force que Physics::tensionF, limitee a maxTensionForce
+		template <typename V>
+		Vec3<V> springForce(const Vec3<V>& p1, const Vec3<V>& p2, const Vec3<V>& v1, const Vec3<V>& v2, V valid, V restLength, const TensionParams& params)
+		{
+			Vec3<V> d{ p2.x - p1.x, p2.y - p1.y, p2.z - p1.z };
+			Vec3<V> relativeVelocity{ v2.x - v1.x, v2.y - v1.y, v2.z - v1.z };
+			V distance = sqrt(dot3(d, d));
+
+			// Hooke + amortissement, tous deux colineaires a d
+			V scale = fmadd(V::set1(params.stiffness), distance - restLength, V::set1(params.damping) * dot3(relativeVelocity, d));
+			Vec3<V> force{ scale * d.x, scale * d.y, scale * d.z };
+
+			V forceNorm = sqrt(dot3(force, force));
+			V maxForce = V::set1(params.maxTensionForce);
+			V clampScale = select(gt(forceNorm, maxForce), maxForce / forceNorm, V::set1(1.0f));
+
+			V zero = V::set1(0.0f);
+			clampScale = select(andMask(ge(distance, V::set1(1e-6f)), gt(valid, V::set1(0.5f))), clampScale, zero);
+			return { force.x * clampScale, force.y * clampScale, force.z * clampScale };
+		}
+
+		template <typename V>
+		void tension(SplitLayout& layout, const TensionParams& params)
+		{
+			const size_t resY = layout.resolutionY;
+			const size_t halo = layout.halo;
+			const V restX = V::set1(params.restLengthX);
+			const V restY = V::set1(params.restLengthY);
+
+			// 1) Une force par ressort, (k, k + 1) et (k, k + resY) : les voisins sont contigus, chargement non aligne
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				Vec3<V> p1 = load3<V>(layout.positions, k);
+				Vec3<V> v1 = load3<V>(layout.velocities, k);
+
+				Vec3<V> forceY = springForce(p1, loadu3<V>(layout.positions, k + 1), v1, loadu3<V>(layout.velocities, k + 1), V::load(layout.validSpringY.data() + k), restY, params);
+				store3(layout.springForceY, halo + k, forceY);
+
+				Vec3<V> forceX = springForce(p1, loadu3<V>(layout.positions, k + resY), v1, loadu3<V>(layout.velocities, k + resY), V::load(layout.validSpringX.data() + k), restX, params);
+				store3(layout.springForceX, halo + k, forceX);
+			});
+
+			// 2) Chaque point recoit +F de ses ressorts sortants et -F de ses ressorts entrants
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				Vec3<V> outY = load3<V>(layout.springForceY, halo + k);
+				Vec3<V> inY = loadu3<V>(layout.springForceY, halo + k - 1);
+				Vec3<V> outX = load3<V>(layout.springForceX, halo + k);
+				Vec3<V> inX = loadu3<V>(layout.springForceX, halo + k - resY);
+				addTo3(layout.accelerations, k, Vec3<V>{
+					(outY.x - inY.x) + (outX.x - inX.x),
+					(outY.y - inY.y) + (outX.y - inX.y),
+					(outY.z - inY.z) + (outX.z - inX.z) });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Vent
+		template <typename V>
+		void wind(SplitLayout& layout, const WindParams& params)
+		{
+			const Vec3<V> dir{ V::set1(params.directionX), V::set1(params.directionY), V::set1(params.directionZ) };
+			const V amplitude = V::set1(params.amplitude);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				V surfaceFactor = min(max(dot3(load3<V>(layout.normals, k), dir), V::set1(0.0f)), V::set1(1.0f));
+				V scale = amplitude * surfaceFactor;
+				addTo3(layout.accelerations, k, Vec3<V>{ dir.x * scale, dir.y * scale, dir.z * scale });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Vent par triangle
+		// Le quad k a les triangles A = (k, k + resY + 1, k + 1) et B = (k, k + resY, k + resY + 1), comme TissuSoA::generateEBOBuffer
+		template <typename V>
+		Vec3<V> aeroForce(const Vec3<V>& p0, const Vec3<V>& p1, const Vec3<V>& p2, const Vec3<V>& velocitySum, const Vec3<V>& air, V valid, const AeroWindParams& params)
+		{
+			const Vec3<V> e1{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+			const Vec3<V> e2{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+			const Vec3<V> n{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+			const V velocityScale = V::set1(-params.velocityScale);
+			const Vec3<V> relative{ fmadd(velocitySum.x, velocityScale, air.x), fmadd(velocitySum.y, velocityScale, air.y), fmadd(velocitySum.z, velocityScale, air.z) };
+
+			const V flux = dot3(n, relative);
+			const V speed2 = dot3(relative, relative);
+			const V invNormSpeed = V::set1(1.0f) / sqrt(max(dot3(n, n) * speed2, V::set1(1e-30f)));
+			const V absFlux = max(flux, V::set1(0.0f) - flux);
+			const V liftScale = V::set1(params.liftFactor) * flux * invNormSpeed;
+			const V relativeScale = (V::set1(params.dragFactor) * absFlux - liftScale * flux) * valid;
+			const V normalScale = liftScale * speed2 * valid;
+			return { fmadd(relativeScale, relative.x, normalScale * n.x), fmadd(relativeScale, relative.y, normalScale * n.y), fmadd(relativeScale, relative.z, normalScale * n.z) };
+		}
+
+		template <typename V>
+		void windTriangles(SplitLayout& layout, const AeroWindParams& params)
+		{
+			const size_t resY = layout.resolutionY;
+			const size_t halo = layout.halo;
+			const Vec3<V> air{ V::set1(params.airVelocityX), V::set1(params.airVelocityY), V::set1(params.airVelocityZ) };
+
+			// 1) Les deux triangles de chaque quad, sans branche : les quads hors grille (derniere ligne / colonne, padding) ont valid = 0
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				Vec3<V> p0 = load3<V>(layout.positions, k);
+				Vec3<V> p1 = loadu3<V>(layout.positions, k + 1);
+				Vec3<V> p2 = loadu3<V>(layout.positions, k + resY + 1);
+				Vec3<V> p3 = loadu3<V>(layout.positions, k + resY);
+				Vec3<V> v0 = load3<V>(layout.velocities, k);
+				Vec3<V> v1 = loadu3<V>(layout.velocities, k + 1);
+				Vec3<V> v2 = loadu3<V>(layout.velocities, k + resY + 1);
+				Vec3<V> v3 = loadu3<V>(layout.velocities, k + resY);
+				Vec3<V> v02{ v0.x + v2.x, v0.y + v2.y, v0.z + v2.z };
+				V valid = V::load(layout.validSpringX.data() + k) * V::load(layout.validSpringY.data() + k);
+
+				store3(layout.triangleForceA, halo + k, aeroForce(p0, p2, p1, Vec3<V>{ v02.x + v1.x, v02.y + v1.y, v02.z + v1.z }, air, valid, params));
+				store3(layout.triangleForceB, halo + k, aeroForce(p0, p3, p2, Vec3<V>{ v02.x + v3.x, v02.y + v3.y, v02.z + v3.z }, air, valid, params));
+			});
+
+			// 2) Chaque point recoit un tiers de ses 6 triangles : A et B du quad k, A du quad k - 1, B du quad k - resY, A et B du quad k - resY - 1
+			const V share = V::set1(params.vertexShare);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				Vec3<V> a0 = load3<V>(layout.triangleForceA, halo + k);
+				Vec3<V> b0 = load3<V>(layout.triangleForceB, halo + k);
+				Vec3<V> a1 = loadu3<V>(layout.triangleForceA, halo + k - 1);
+				Vec3<V> b1 = loadu3<V>(layout.triangleForceB, halo + k - resY);
+				Vec3<V> a2 = loadu3<V>(layout.triangleForceA, halo + k - resY - 1);
+				Vec3<V> b2 = loadu3<V>(layout.triangleForceB, halo + k - resY - 1);
+				addTo3(layout.accelerations, k, Vec3<V>{
+					((a0.x + b0.x) + (a1.x + b1.x) + (a2.x + b2.x)) * share,
+					((a0.y + b0.y) + (a1.y + b1.y) + (a2.y + b2.y)) * share,
+					((a0.z + b0.z) + (a1.z + b1.z) + (a2.z + b2.z)) * share });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Collision Sphere
+		template <typename V>
+		void sphereCollision(SplitLayout& layout, const SphereParams& params)
+		{
+			const Vec3<V> center{ V::set1(params.centerX), V::set1(params.centerY), V::set1(params.centerZ) };
+			const V radius = V::set1(params.radiusWithGap);
+			const V stiffness = V::set1(params.stiffness);
+			const V zero = V::set1(0.0f);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				Vec3<V> p = load3<V>(layout.positions, k);
+				Vec3<V> d{ p.x - center.x, p.y - center.y, p.z - center.z };
+				V distance = sqrt(dot3(d, d));
+
+				// Normale (0, 1, 0) si le point est exactement au centre
+				auto hasDirection = gt(distance, zero);
+				V invDistance = select(hasDirection, V::set1(1.0f) / distance, zero);
+				Vec3<V> normal{ d.x * invDistance, select(hasDirection, d.y * invDistance, V::set1(1.0f)), d.z * invDistance };
+
+				V scale = select(le(distance, radius), (radius - distance) * stiffness, zero);
+				addTo3(layout.accelerations, k, Vec3<V>{ normal.x * scale, normal.y * scale, normal.z * scale });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Collision Boite (SDF), normale par difference centrale comme applyBoxCollisionResponse_SDF
+		template <typename V>
+		V sdfBox(const Vec3<V>& p, const Vec3<V>& halfSize)
+		{
+			V zero = V::set1(0.0f);
+			Vec3<V> d{ abs(p.x) - halfSize.x, abs(p.y) - halfSize.y, abs(p.z) - halfSize.z };
+			Vec3<V> outside{ max(d.x, zero), max(d.y, zero), max(d.z, zero) };
+			return sqrt(dot3(outside, outside)) + min(max(d.x, max(d.y, d.z)), zero);
+		}
+
+		template <typename V>
+		void boxCollision(SplitLayout& layout, const BoxParams& params)
+		{
+			const Vec3<V> center{ V::set1(params.centerX), V::set1(params.centerY), V::set1(params.centerZ) };
+			const Vec3<V> halfSize{ V::set1(params.halfSizeX), V::set1(params.halfSizeY), V::set1(params.halfSizeZ) };
+			const float* r = params.rotation;
+			const V stiffness = V::set1(params.stiffness);
+			const V h = V::set1(0.001f);
+			const V zero = V::set1(0.0f);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				Vec3<V> p = load3<V>(layout.positions, k);
+				Vec3<V> d{ p.x - center.x, p.y - center.y, p.z - center.z };
+				// localPos = transpose(rotation) * d
+				Vec3<V> local{
+					fmadd(V::set1(r[0]), d.x, fmadd(V::set1(r[1]), d.y, V::set1(r[2]) * d.z)),
+					fmadd(V::set1(r[3]), d.x, fmadd(V::set1(r[4]), d.y, V::set1(r[5]) * d.z)),
+					fmadd(V::set1(r[6]), d.x, fmadd(V::set1(r[7]), d.y, V::set1(r[8]) * d.z)) };
+				V dist = sdfBox(local, halfSize);
+
+				Vec3<V> gradient{
+					sdfBox(Vec3<V>{ local.x + h, local.y, local.z }, halfSize) - sdfBox(Vec3<V>{ local.x - h, local.y, local.z }, halfSize),
+					sdfBox(Vec3<V>{ local.x, local.y + h, local.z }, halfSize) - sdfBox(Vec3<V>{ local.x, local.y - h, local.z }, halfSize),
+					sdfBox(Vec3<V>{ local.x, local.y, local.z + h }, halfSize) - sdfBox(Vec3<V>{ local.x, local.y, local.z - h }, halfSize) };
+				V gradientNorm = sqrt(dot3(gradient, gradient));
+
+				auto inside = andMask(lt(dist, zero), gt(gradientNorm, zero));
+				V scale = select(inside, (zero - dist) * stiffness / gradientNorm, zero);
+				// worldNormal = rotation * normal
+				addTo3(layout.accelerations, k, Vec3<V>{
+					fmadd(V::set1(r[0]), gradient.x, fmadd(V::set1(r[3]), gradient.y, V::set1(r[6]) * gradient.z)) * scale,
+					fmadd(V::set1(r[1]), gradient.x, fmadd(V::set1(r[4]), gradient.y, V::set1(r[7]) * gradient.z)) * scale,
+					fmadd(V::set1(r[2]), gradient.x, fmadd(V::set1(r[5]), gradient.y, V::set1(r[8]) * gradient.z)) * scale });
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Integration de Verlet : x(t + 1) = x(t) + [x(t) - x(t - 1)] * frottement + F(t) * invMass * dt2
+		// Un point libre qui passe sous le sol y est colle et devient fixe (invMass = 0)
+		template <typename V>
+		void verlet(SplitLayout& layout, const VerletParams& params)
+		{
+			const V dt2 = V::set1(params.dt2);
+			const V floor = V::set1(params.floorHeight);
+			const V zero = V::set1(0.0f);
+			const bool hasDrag = params.dragLinear != 0.0f || params.dragQuadratic != 0.0f;
+			const V one = V::set1(1.0f);
+			const V dragLinear = V::set1(params.dragLinear);
+			const V dragQuadratic = V::set1(params.dragQuadratic);
+			forEachBlock<V>(layout.paddedCount, [&](size_t k) {
+				V invMass = V::load(layout.invMasses.data() + k);
+				Vec3<V> p = load3<V>(layout.positions, k);
+				Vec3<V> v = load3<V>(layout.velocities, k);
+				Vec3<V> a = load3<V>(layout.accelerations, k);
+				if (hasDrag) {
+					V drag = one / fmadd(fmadd(dragQuadratic, sqrt(dot3(v, v)), dragLinear), invMass, one);
+					v = Vec3<V>{ v.x * drag, v.y * drag, v.z * drag };
+				}
+
+				auto isMovable = gt(invMass, zero);
+				auto isAbove = gt(p.z, floor);
+				auto moves = andMask(isMovable, isAbove);
+				auto lands = andMask(isMovable, le(p.z, floor));
+				V step = invMass * dt2;
+
+				Vec3<V> newP{
+					select(moves, fmadd(a.x, step, p.x + v.x), p.x),
+					select(moves, fmadd(a.y, step, p.y + v.y), p.y),
+					select(lands, floor, select(moves, fmadd(a.z, step, p.z + v.z), p.z)) };
+
+				store3(layout.velocities, k, Vec3<V>{ newP.x - p.x, newP.y - p.y, newP.z - p.z });
+				store3(layout.positions, k, newP);
+				select(lands, zero, invMass).store(layout.invMasses.data() + k);
+			});
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		template <typename V>
+		KernelTable makeKernelTable(InstructionSet instructionSet)
+		{
+			return KernelTable{
+				instructionSet,
+				&resetAcceleration<V>,
+				&gravity<V>,
+				&tension<V>,
+				&wind<V>,
+				&windTriangles<V>,
+				&sphereCollision<V>,
+				&boxCollision<V>,
+				&verlet<V>,
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <cmath>
+#include "simd_kernels_impl.h"
+
+// ----------------------------------------------------------------------------------------------------
+// Repli scalaire des noyaux SIMD (un float par "registre"), utilise si le CPU n'a ni AVX2 ni AVX-512
+
+namespace
+{
+	struct ScalarVec {
+		static constexpr int width = 1;
+		struct Mask { bool m; };
+		float v;
+
+		static ScalarVec load(const float* p) { return { *p }; }
+		static ScalarVec loadu(const float* p) { return { *p }; }
+		static ScalarVec set1(float f) { return { f }; }
+		void store(float* p) const { *p = v; }
+		void storeu(float* p) const { *p = v; }
+
+		friend ScalarVec operator+(ScalarVec a, ScalarVec b) { return { a.v + b.v }; }
+		friend ScalarVec operator-(ScalarVec a, ScalarVec b) { return { a.v - b.v }; }
+		friend ScalarVec operator*(ScalarVec a, ScalarVec b) { return { a.v * b.v }; }
+		friend ScalarVec operator/(ScalarVec a, ScalarVec b) { return { a.v / b.v }; }
+		friend ScalarVec fmadd(ScalarVec a, ScalarVec b, ScalarVec c) { return { a.v * b.v + c.v }; }
+		friend ScalarVec sqrt(ScalarVec a) { return { std::sqrt(a.v) }; }
+		friend ScalarVec min(ScalarVec a, ScalarVec b) { return { std::min(a.v, b.v) }; }
+		friend ScalarVec max(ScalarVec a, ScalarVec b) { return { std::max(a.v, b.v) }; }
+		friend ScalarVec abs(ScalarVec a) { return { std::fabs(a.v) }; }
+
+		friend Mask lt(ScalarVec a, ScalarVec b) { return { a.v < b.v }; }
+		friend Mask le(ScalarVec a, ScalarVec b) { return { a.v <= b.v }; }
+		friend Mask gt(ScalarVec a, ScalarVec b) { return { a.v > b.v }; }
+		friend Mask ge(ScalarVec a, ScalarVec b) { return { a.v >= b.v }; }
+		friend Mask andMask(Mask a, Mask b) { return { a.m && b.m }; }
+		friend ScalarVec select(Mask m, ScalarVec a, ScalarVec b) { return m.m ? a : b; }
+	};
+}
+
+namespace Simd
+{
+	const KernelTable& scalarKernels()
+	{
+		static const KernelTable table = Impl::makeKernelTable<ScalarVec>(InstructionSet::SCALAR);
+		return table;
+	}
+}
@@ -0,0 +1,208 @@
+#ifndef SIMULATION_CONFIG_H
+#define SIMULATION_CONFIG_H
+
+#include <iostream>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include "tissuSoA.h"
+#include "physicSoA.h"
+#include "scene.h"
+
+// ----------------------------------------------------------------------------------------------------
+// Partie du fichier de config qui ne depend ni de GLFW ni d'OpenGL (utilisable en headless)
+
+// ----------------------------------------------------------------------------------------------------
+// Quick Test
+bool debug;
+
+bool activateSphere;
+bool activateBox;
+bool activateCylinder;
+bool activateCone;
+
+bool lockCorner;
+
+// -------------------------------------------------------------------------------------------
+//                Simulation Settings
+// Tissu Settings
+Tissu::TissuSettings tissuSettings;
+// Physics Settings
+Physics::PhysicsSettings physicsSettings;
+// Scene Settings (un tissu par entree de "scene.cloths", ou le tissu de base si la liste est vide)
+Scene::SceneSettings sceneSettings;
+
+// -------------------------------------------------------------------------------------------
+
+namespace Config
+{
+	bool readJSON(const std::string& path, nlohmann::json& j) {
+		std::ifstream file(path);
+		if (!file.is_open()) {
+			std::cerr << "Erreur: impossible d'ouvrir le fichier " << path << std::endl;
+			return false;
+		}
+		file >> j;
+		return true;
+	}
+
+	void parseTissuSettings(nlohmann::json& j, Tissu::TissuSettings& tissuSettings) {
+		tissuSettings.sizeX = j["tissu"]["sizeX"];
+		tissuSettings.sizeY = j["tissu"]["sizeY"];
+		tissuSettings.mass = j["tissu"]["mass"];
+		// massMap : tableau de resolutionX * resolutionY masses (x * resolutionY + y), ou chemin d'un fichier JSON qui le contient
+		nlohmann::json massMap = j["tissu"]["massMap"];
+		if (massMap.is_string() && !readJSON(massMap.get<std::string>(), massMap))
+			massMap = nlohmann::json::array();
+		tissuSettings.massMap = massMap.get<std::vector<float>>();
+		tissuSettings.resolutionX = j["tissu"]["resolutionX"];
+		tissuSettings.resolutionY = j["tissu"]["resolutionY"];
+		tissuSettings.startingHeight = j["tissu"]["startingHeight"];
+		tissuSettings.floorHeight = j["tissu"]["floorHeight"];
+		tissuSettings.ordering = Tissu::parseVertexOrdering(j["tissu"]["ordering"]);
+		tissuSettings.gapPointStartX = tissuSettings.sizeX / tissuSettings.resolutionX;
+		tissuSettings.gapPointStartY = tissuSettings.sizeY / tissuSettings.resolutionY;
+	}
+
+	void parsePhysicsSettings(nlohmann::json& j, const Tissu::TissuSettings& tissuSettings, Physics::PhysicsSettings& physicsSettings) {
+		physicsSettings.gravitySettings.amplitude = j["physics"]["gravity"]["amplitude"];
+		physicsSettings.gravitySettings.directionVector = glm::vec3(
+			j["physics"]["gravity"]["directionVector"][0],
+			j["physics"]["gravity"]["directionVector"][1],
+			j["physics"]["gravity"]["directionVector"][2]
+		);
+		physicsSettings.gravitySettings.isEnabled = j["physics"]["gravity"]["isEnabled"];
+
+		physicsSettings.tensionSettings.longeurVideRessortX = tissuSettings.gapPointStartX;
+		physicsSettings.tensionSettings.longeurVideRessortY = tissuSettings.gapPointStartY;
+		physicsSettings.tensionSettings.force = j["physics"]["tension"]["force"];
+		physicsSettings.tensionSettings.maxTensionForce = j["physics"]["tension"]["maxTensionForce"];
+		physicsSettings.tensionSettings.damping = j["physics"]["tension"]["damping"];
+		physicsSettings.tensionSettings.isEnabled = j["physics"]["tension"]["isEnabled"];
+		physicsSettings.tensionSettings.shear.force = j["physics"]["tension"]["shear"]["force"];
+		physicsSettings.tensionSettings.shear.isEnabled = j["physics"]["tension"]["shear"]["isEnabled"];
+		physicsSettings.tensionSettings.bending.force = j["physics"]["tension"]["bending"]["force"];
+		physicsSettings.tensionSettings.bending.isEnabled = j["physics"]["tension"]["bending"]["isEnabled"];
+
+		physicsSettings.collisionSettings.stiffness = j["physics"]["collision"]["stiffness"];
+		physicsSettings.collisionSettings.antiClippingGap = j["physics"]["collision"]["antiClippingGap"];
+		physicsSettings.collisionSettings.isEnabled = j["physics"]["collision"]["isEnabled"];
+
+		physicsSettings.windSettings.amplitude = j["physics"]["wind"]["amplitude"];
+		physicsSettings.windSettings.directionVector = glm::vec3(
+			j["physics"]["wind"]["directionVector"][0],
+			j["physics"]["wind"]["directionVector"][1],
+			j["physics"]["wind"]["directionVector"][2]
+		);
+		physicsSettings.windSettings.oscillationFrequency = j["physics"]["wind"]["oscillationFrequency"];
+		physicsSettings.windSettings.isOscillate = j["physics"]["wind"]["isOscillate"];
+		physicsSettings.windSettings.isEnabled = j["physics"]["wind"]["isEnabled"];
+		physicsSettings.windSettings.model = Physics::parseWindModel(j["physics"]["wind"]["model"]);
+		physicsSettings.windSettings.airSpeed = j["physics"]["wind"]["aero"]["airSpeed"];
+		physicsSettings.windSettings.airDensity = j["physics"]["wind"]["aero"]["airDensity"];
+		physicsSettings.windSettings.dragCoefficient = j["physics"]["wind"]["aero"]["dragCoefficient"];
+		physicsSettings.windSettings.liftCoefficient = j["physics"]["wind"]["aero"]["liftCoefficient"];
+
+		physicsSettings.dragSettings.linear = j["physics"]["drag"]["linear"];
+		physicsSettings.dragSettings.quadratic = j["physics"]["drag"]["quadratic"];
+		physicsSettings.dragSettings.isEnabled = j["physics"]["drag"]["isEnabled"];
+
+		physicsSettings.temporalSettings.dt = j["physics"]["temporal"]["dt"];
+		physicsSettings.temporalSettings.substeps = j["physics"]["temporal"]["substeps"];
+		physicsSettings.temporalSettings.integrator = Physics::parseIntegrator(j["physics"]["temporal"]["integrator"]);
+		physicsSettings.temporalSettings.adaptive.isEnabled = j["physics"]["temporal"]["adaptive"]["isEnabled"];
+		physicsSettings.temporalSettings.adaptive.minSubsteps = j["physics"]["temporal"]["adaptive"]["minSubsteps"];
+		physicsSettings.temporalSettings.adaptive.maxSubsteps = j["physics"]["temporal"]["adaptive"]["maxSubsteps"];
+		physicsSettings.temporalSettings.adaptive.cflNumber = j["physics"]["temporal"]["adaptive"]["cflNumber"];
+		physicsSettings.temporalSettings.adaptive.maxStrainPerSubstep = j["physics"]["temporal"]["adaptive"]["maxStrainPerSubstep"];
+
+		physicsSettings.implicitSettings.steps = j["physics"]["implicit"]["steps"];
+		physicsSettings.implicitSettings.maxIterations = j["physics"]["implicit"]["maxIterations"];
+		physicsSettings.implicitSettings.tolerance = j["physics"]["implicit"]["tolerance"];
+
+		physicsSettings.xpbdSettings.substeps = j["physics"]["xpbd"]["substeps"];
+		physicsSettings.xpbdSettings.iterations = j["physics"]["xpbd"]["iterations"];
+
+		physicsSettings.projectiveSettings.steps = j["physics"]["projective"]["steps"];
+		physicsSettings.projectiveSettings.iterations = j["physics"]["projective"]["iterations"];
+
+		physicsSettings.grabSettings.force = j["physics"]["grab"]["force"];
+		physicsSettings.grabSettings.damping = j["physics"]["grab"]["damping"];
+		physicsSettings.grabSettings.isEnabled = j["physics"]["grab"]["isEnabled"];
+
+		physicsSettings.selfCollisionSettings.model = Physics::parseSelfCollisionModel(j["physics"]["selfCollision"]["model"]);
+		physicsSettings.selfCollisionSettings.minDistance = j["physics"]["selfCollision"]["minDistance"];
+		physicsSettings.selfCollisionSettings.cellSize = j["physics"]["selfCollision"]["cellSize"];
+		physicsSettings.selfCollisionSettings.skinDistance = j["physics"]["selfCollision"]["skinDistance"];
+		physicsSettings.selfCollisionSettings.excludedRings = j["physics"]["selfCollision"]["excludedRings"];
+		physicsSettings.selfCollisionSettings.isEnabled = j["physics"]["selfCollision"]["isEnabled"];
+
+		physicsSettings.fusedSettings.isEnabled = j["physics"]["fused"]["isEnabled"];
+
+		physicsSettings.simdSettings.instructionSet = Simd::parseInstructionSet(j["physics"]["simd"]["instructionSet"]);
+		physicsSettings.simdSettings.isEnabled = j["physics"]["simd"]["isEnabled"];
+
+		physicsSettings.sleepSettings.tileSize = j["physics"]["sleep"]["tileSize"];
+		physicsSettings.sleepSettings.energyThreshold = j["physics"]["sleep"]["energyThreshold"];
+		physicsSettings.sleepSettings.calmSubsteps = j["physics"]["sleep"]["calmSubsteps"];
+		physicsSettings.sleepSettings.isEnabled = j["physics"]["sleep"]["isEnabled"];
+
+		physicsSettings.precisionSettings.mode = Physics::parsePrecision(j["physics"]["precision"]["mode"]);
+	}
+
+	// Chaque tissu de la scene reprend la config de base, ses blocs "tissu" et "physics" ne donnent que les valeurs qui changent
+	void parseSceneSettings(nlohmann::json& j) {
+		sceneSettings.minVerticesForInnerParallel = j["scene"]["minVerticesForInnerParallel"];
+		sceneSettings.cloths.clear();
+
+		nlohmann::json& cloths = j["scene"]["cloths"];
+		if (cloths.empty()) {
+			Scene::ClothSettings clothSettings;
+			clothSettings.tissuSettings = tissuSettings;
+			clothSettings.physicsSettings = physicsSettings;
+			clothSettings.lockCorner = lockCorner;
+			sceneSettings.cloths.push_back(clothSettings);
+			return;
+		}
+
+		for (nlohmann::json& cloth : cloths) {
+			nlohmann::json clothJson = j;
+			if (cloth.contains("tissu"))
+				clothJson["tissu"].merge_patch(cloth["tissu"]);
+			if (cloth.contains("physics"))
+				clothJson["physics"].merge_patch(cloth["physics"]);
+
+			Scene::ClothSettings clothSettings;
+			clothSettings.name = cloth.value("name", "tissu" + std::to_string(sceneSettings.cloths.size()));
+			clothSettings.lockCorner = cloth.value("lockCorner", lockCorner);
+			parseTissuSettings(clothJson, clothSettings.tissuSettings);
+			if (cloth.contains("origin"))
+				clothSettings.tissuSettings.positionOrigin = glm::vec3(cloth["origin"][0], cloth["origin"][1], cloth["origin"][2]);
+			parsePhysicsSettings(clothJson, clothSettings.tissuSettings, clothSettings.physicsSettings);
+			sceneSettings.cloths.push_back(clothSettings);
+		}
+	}
+
+	void parseSimulationSettings(nlohmann::json& j) {
+		// -------
+		debug = j["debug"];
+		activateSphere = j["activateSphere"];
+		activateBox = j["activateBox"];
+		activateCylinder = j["activateCylinder"];
+		activateCone = j["activateCone"];
+		lockCorner = j["lockCorner"];
+		// -------
+		parseTissuSettings(j, tissuSettings);
+		parsePhysicsSettings(j, tissuSettings, physicsSettings);
+		parseSceneSettings(j);
+		// -------
+	}
+
+	bool loadSimulationFromJSON(const std::string& path) {
+		nlohmann::json j;
+		if (!readJSON(path, j))
+			return false;
+		parseSimulationSettings(j);
+		return true;
+	}
+}
+#endif
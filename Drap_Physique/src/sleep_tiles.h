@@ -0,0 +1,150 @@
+#ifndef SLEEP_TILES_H
+#define SLEEP_TILES_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------------------------------
+// Mise en sommeil du tissu par tuiles
+// La grille (x, y) est decoupee en tuiles de tileSize x tileSize points. Une tuile s'endort quand le deplacement de ses points
+// et de ceux des 8 tuiles voisines reste sous un seuil pendant calmSubsteps substeps : ses points ne sont plus calcules.
+// Un point endormi a ses trois buffers de position egaux : la rotation des buffers le laisse en place, sans aucune ecriture.
+// Une tuile se reveille des qu'une voisine bouge (ressorts tires par la partie eveillee), ou sur demande (grab, vent, reset...).
+
+namespace SleepTiles
+{
+	struct TileGrid {
+		int tileSize = 0;             // 0 : grille non construite
+		int resolutionX = 0;
+		int resolutionY = 0;
+		int tileCountX = 0;
+		int tileCountY = 0;
+
+		std::vector<uint8_t> isAwake;
+		std::vector<int> calmSubsteps;   // Substeps consecutifs sans mouvement dans le voisinage
+		std::vector<float> motion;       // Deplacement max au carre d'un point de la tuile au dernier substep (0 si endormie)
+		std::vector<int> awakeTiles;     // Liste compacte des tuiles eveillees, parcourue par le substep
+		std::vector<int> fallingAsleep;  // Tuiles endormies au dernier update, leurs vitesses sont a remettre a zero
+
+		glm::vec3 externalField = glm::vec3(0.0f); // Gravite + vent au dernier reveil general
+		bool hasExternalField = false;
+
+		// Reveil general demande hors de la boucle physique (console, reset, verrous) : traite au substep suivant
+		bool isWakeRequested = false;
+
+		bool matches(int resX, int resY, int size) const
+		{
+			return tileSize == size && resolutionX == resX && resolutionY == resY;
+		}
+
+		void resize(int resX, int resY, int size)
+		{
+			tileSize = std::max(size, 2); // Les ressorts de flexion sautent un point : il faut au moins 2 points par tuile
+			resolutionX = resX;
+			resolutionY = resY;
+			tileCountX = (resX + tileSize - 1) / tileSize;
+			tileCountY = (resY + tileSize - 1) / tileSize;
+			const size_t tileCount = static_cast<size_t>(tileCountX) * tileCountY;
+			isAwake.assign(tileCount, 1);
+			calmSubsteps.assign(tileCount, 0);
+			motion.assign(tileCount, 0.0f);
+			fallingAsleep.clear();
+			hasExternalField = false;
+			rebuildAwakeList();
+		}
+
+		void clear()
+		{
+			tileSize = 0;
+			isAwake.clear();
+			calmSubsteps.clear();
+			motion.clear();
+			awakeTiles.clear();
+			fallingAsleep.clear();
+			hasExternalField = false;
+		}
+
+		inline int tileCount() const { return tileCountX * tileCountY; }
+
+		// Points de la tuile t : x dans [xBegin, xEnd), y dans [yBegin, yEnd)
+		inline void bounds(int t, int& xBegin, int& xEnd, int& yBegin, int& yEnd) const
+		{
+			xBegin = (t / tileCountY) * tileSize;
+			yBegin = (t % tileCountY) * tileSize;
+			xEnd = std::min(xBegin + tileSize, resolutionX);
+			yEnd = std::min(yBegin + tileSize, resolutionY);
+		}
+
+		void wakeAll()
+		{
+			std::fill(isAwake.begin(), isAwake.end(), static_cast<uint8_t>(1));
+			std::fill(calmSubsteps.begin(), calmSubsteps.end(), 0);
+			rebuildAwakeList();
+		}
+
+		// Reveille la tuile du point (x, y) et ses voisines
+		void wakeAround(int x, int y)
+		{
+			const int tx = x / tileSize;
+			const int ty = y / tileSize;
+			bool hasChanged = false;
+			for (int nx = std::max(tx - 1, 0); nx <= std::min(tx + 1, tileCountX - 1); nx++) {
+				for (int ny = std::max(ty - 1, 0); ny <= std::min(ty + 1, tileCountY - 1); ny++) {
+					const int t = nx * tileCountY + ny;
+					hasChanged |= isAwake[t] == 0;
+					isAwake[t] = 1;
+					calmSubsteps[t] = 0;
+				}
+			}
+			if (hasChanged)
+				rebuildAwakeList();
+		}
+
+		void rebuildAwakeList()
+		{
+			awakeTiles.clear();
+			for (int t = 0; t < tileCount(); t++)
+				if (isAwake[t])
+					awakeTiles.push_back(t);
+		}
+
+		// Fin de substep : motion est a jour pour les tuiles eveillees.
+		// Une tuile dont le voisinage 3x3 a bouge de plus du seuil est (re)veillee, sinon son compteur de calme avance.
+		// Retourne le nombre de tuiles endormies pendant cet update (listees dans fallingAsleep).
+		int update(float motionThreshold2, int calmSubstepsRequired)
+		{
+			fallingAsleep.clear();
+			bool hasChanged = false;
+			for (int tx = 0; tx < tileCountX; tx++) {
+				for (int ty = 0; ty < tileCountY; ty++) {
+					const int t = tx * tileCountY + ty;
+					float neighborhoodMotion = 0.0f;
+					for (int nx = std::max(tx - 1, 0); nx <= std::min(tx + 1, tileCountX - 1); nx++)
+						for (int ny = std::max(ty - 1, 0); ny <= std::min(ty + 1, tileCountY - 1); ny++)
+							neighborhoodMotion = std::max(neighborhoodMotion, motion[nx * tileCountY + ny]);
+
+					if (neighborhoodMotion > motionThreshold2) {
+						hasChanged |= isAwake[t] == 0;
+						isAwake[t] = 1;
+						calmSubsteps[t] = 0;
+					}
+					else if (isAwake[t] && ++calmSubsteps[t] >= calmSubstepsRequired) {
+						isAwake[t] = 0;
+						fallingAsleep.push_back(t);
+						hasChanged = true;
+					}
+				}
+			}
+			// Les tuiles endormies ne bougent plus : leur mouvement ne compte plus pour les voisines
+			for (int t : fallingAsleep)
+				motion[t] = 0.0f;
+			if (hasChanged)
+				rebuildAwakeList();
+			return static_cast<int>(fallingAsleep.size());
+		}
+	};
+}
+
+#endif
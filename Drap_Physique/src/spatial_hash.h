@@ -0,0 +1,239 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <omp.h>
+
+// ----------------------------------------------------------------------------------------------------
+// Grille uniforme hachee pour l'auto-collision
+// L'espace est decoupe en cellules cubiques de cote cellSize, chaque cellule (x, y, z) tombe dans un seau d'une table
+// de taille fixe (puissance de 2, au moins deux seaux par point). La table est construite par tri par comptage :
+//   1) cellule et seau de chaque point ;
+//   2) nombre de points par seau, puis somme prefixe -> cellStart ;
+//   3) dispersion des indices dans un seul tableau plat (sortedIndices).
+// Les points du seau b sont sortedIndices[cellStart[b]] ... sortedIndices[cellStart[b + 1] - 1] : une requete parcourt
+// des plages contigues. Deux cellules peuvent partager un seau, les requetes comparent donc aussi la cellule du point.
+// Les etapes 1 a 3 sont paralleles (compteurs atomiques) ; chaque seau est ensuite trie par indice : la grille
+// ne depend pas de l'ordre des threads et la simulation reste reproductible.
+// Les constructions et hasMovedBeyond sont des boucles "omp for" orphelines : a appeler par tous les threads
+// d'une region parallele (comme les phases de l'auto-collision), ou hors region (un seul thread).
+
+namespace SpatialHash
+{
+	struct HashGrid {
+		float cellSize = 0.0f;
+		uint32_t bucketMask = 0;
+
+		std::vector<uint32_t> cellStart;     // bucketCount + 1 entrees
+		std::vector<uint32_t> sortedIndices; // Indices des points, ranges par seau
+		std::vector<glm::ivec3> pointCells;  // Cellule de chaque point
+		std::vector<uint32_t> pointBuckets;  // Seau de chaque point
+		std::vector<uint32_t> cursors;       // Position d'ecriture de chaque seau pendant la dispersion
+		std::vector<uint32_t> blockSums;     // Somme prefixe : total du bloc de chaque thread
+
+		inline size_t bucketCount() const { return cellStart.empty() ? 0 : cellStart.size() - 1; }
+
+		inline glm::ivec3 cellOf(const glm::vec3& position) const
+		{
+			return glm::ivec3(glm::floor(position / cellSize));
+		}
+
+		// Hachage de Teschner et al. (grands premiers, ou exclusif)
+		inline uint32_t bucketOf(const glm::ivec3& cell) const
+		{
+			const uint32_t h = (static_cast<uint32_t>(cell.x) * 92837111u) ^ (static_cast<uint32_t>(cell.y) * 689287499u) ^ (static_cast<uint32_t>(cell.z) * 283923481u);
+			return h & bucketMask;
+		}
+
+		void build(const std::vector<glm::vec3>& positions, float cellSizeIn)
+		{
+			const int count = static_cast<int>(positions.size());
+			size_t buckets = 1;
+			while (buckets < 2 * positions.size())
+				buckets <<= 1;
+			const int bucketTotal = static_cast<int>(buckets);
+			const int threadCount = omp_get_num_threads();
+			const int thread = omp_get_thread_num();
+
+			#pragma omp single
+			{
+				cellSize = cellSizeIn;
+				bucketMask = static_cast<uint32_t>(buckets - 1);
+				cellStart.assign(buckets + 1, 0);
+				cursors.resize(buckets);
+				sortedIndices.resize(count);
+				pointCells.resize(count);
+				pointBuckets.resize(count);
+				blockSums.assign(threadCount + 1, 0);
+			}
+
+			// 1) Cellule et seau, 2) comptage (le compteur du seau b est range en cellStart[b + 1])
+			#pragma omp for
+			for (int i = 0; i < count; i++) {
+				pointCells[i] = cellOf(positions[i]);
+				pointBuckets[i] = bucketOf(pointCells[i]);
+				std::atomic_ref<uint32_t>(cellStart[pointBuckets[i] + 1]).fetch_add(1, std::memory_order_relaxed);
+			}
+
+			// Somme prefixe par blocs : chaque thread somme son bloc, les totaux des blocs sont cumules, puis chaque bloc est decale
+			{
+				const int begin = 1 + static_cast<int>(static_cast<int64_t>(bucketTotal) * thread / threadCount);
+				const int end = 1 + static_cast<int>(static_cast<int64_t>(bucketTotal) * (thread + 1) / threadCount);
+				for (int b = begin + 1; b < end; b++)
+					cellStart[b] += cellStart[b - 1];
+				blockSums[thread + 1] = end > begin ? cellStart[end - 1] : 0;
+				#pragma omp barrier
+				#pragma omp single
+				for (int t = 1; t <= threadCount; t++)
+					blockSums[t] += blockSums[t - 1];
+				for (int b = begin; b < end; b++)
+					cellStart[b] += blockSums[thread];
+				#pragma omp barrier // Les blocs ne suivent pas le decoupage des "omp for" : tous decales avant la lecture de cellStart
+			}
+
+			// 3) Dispersion
+			#pragma omp for
+			for (int b = 0; b < bucketTotal; b++)
+				cursors[b] = cellStart[b];
+			#pragma omp for
+			for (int i = 0; i < count; i++) {
+				const uint32_t slot = std::atomic_ref<uint32_t>(cursors[pointBuckets[i]]).fetch_add(1, std::memory_order_relaxed);
+				sortedIndices[slot] = static_cast<uint32_t>(i);
+			}
+
+			// Ordre des threads -> ordre des indices dans chaque seau (quelques points par seau)
+			#pragma omp for schedule(static, 1024)
+			for (int b = 0; b < bucketTotal; b++)
+				if (cellStart[b + 1] - cellStart[b] > 1)
+					std::sort(sortedIndices.begin() + cellStart[b], sortedIndices.begin() + cellStart[b + 1]);
+		}
+
+		// Appelle visit(j) pour chaque point j != i a moins de sqrt(radius2) de positions[i] (radius <= cellSize),
+		// dans l'ordre des cellules voisines puis des indices
+		template <typename Visitor>
+		inline void forEachNeighbor(const std::vector<glm::vec3>& positions, uint32_t i, float radius2, Visitor&& visit) const
+		{
+			const glm::ivec3 cell = pointCells[i];
+			for (int dx = -1; dx <= 1; ++dx) {
+				for (int dy = -1; dy <= 1; ++dy) {
+					for (int dz = -1; dz <= 1; ++dz) {
+						const glm::ivec3 neighborCell = cell + glm::ivec3(dx, dy, dz);
+						const uint32_t bucket = bucketOf(neighborCell);
+						for (uint32_t k = cellStart[bucket]; k < cellStart[bucket + 1]; ++k) {
+							const uint32_t j = sortedIndices[k];
+							if (j == i || pointCells[j] != neighborCell) continue; // lui-meme ou autre cellule du meme seau
+							const glm::vec3 delta = positions[i] - positions[j];
+							if (glm::dot(delta, delta) < radius2)
+								visit(j);
+						}
+					}
+				}
+			}
+		}
+
+		void clear()
+		{
+			cellStart.clear();
+			sortedIndices.clear();
+			pointCells.clear();
+			pointBuckets.clear();
+			cursors.clear();
+		}
+	};
+	// ----------------------------------------------------------------------------------------------------
+	// Listes de voisins persistantes (listes de Verlet)
+	// Les voisins de chaque point a moins de radius = minDistance + skin sont gardes en CSR : les voisins de i sont
+	// neighbors[offsets[i]] ... neighbors[offsets[i + 1] - 1]. Tant qu'aucun point n'a bouge de plus de skin / 2 depuis
+	// la construction, deux points a moins de minDistance sont forcement dans la liste : les substeps suivants ne testent
+	// que ces paires, sans reconstruire la grille.
+	struct NeighborList {
+		std::vector<uint32_t> offsets;           // count + 1 entrees
+		std::vector<uint32_t> neighbors;
+		std::vector<glm::vec3> referencePositions; // Positions a la construction
+		float radius = -1.0f;                    // < 0 : liste non construite
+		int movedFlag = 0;                       // Reduction partagee de hasMovedBeyond
+
+		bool isEmpty() const { return radius < 0.0f; }
+
+		// Un point s'est deplace de plus de distance depuis la construction (meme reponse pour tous les threads)
+		// Reduction a la main dans movedFlag, partage par l'equipe (OpenMP 2.0 : pas de reduction sur un membre)
+		bool hasMovedBeyond(const std::vector<glm::vec3>& positions, float distance)
+		{
+			const int count = static_cast<int>(positions.size());
+			const float distance2 = distance * distance;
+			#pragma omp single
+			movedFlag = 0;
+
+			int localMoved = 0;
+			#pragma omp for nowait
+			for (int i = 0; i < count; i++) {
+				const glm::vec3 delta = positions[i] - referencePositions[i];
+				if (glm::dot(delta, delta) > distance2)
+					localMoved |= 1;
+			}
+			if (localMoved) {
+				#pragma omp atomic
+				movedFlag |= 1;
+			}
+			#pragma omp barrier
+			const bool hasMoved = movedFlag != 0;
+			#pragma omp barrier // Tous les threads ont lu movedFlag avant un autre appel
+			return hasMoved;
+		}
+
+		// Deux passes sur la grille (comptage puis remplissage) : l'ordre des voisins est celui de la grille, independant des threads.
+		// isExcluded(i, j) retire les paires a ne jamais tester (voisins dans la topologie)
+		template <typename Excluded>
+		void build(const HashGrid& grid, const std::vector<glm::vec3>& positions, float radiusIn, Excluded&& isExcluded)
+		{
+			const int count = static_cast<int>(positions.size());
+			const float radius2 = radiusIn * radiusIn;
+			#pragma omp single
+			{
+				radius = radiusIn;
+				offsets.assign(count + 1, 0);
+				referencePositions.resize(count);
+			}
+
+			#pragma omp for schedule(dynamic, 256)
+			for (int i = 0; i < count; i++) {
+				uint32_t neighborCount = 0;
+				grid.forEachNeighbor(positions, static_cast<uint32_t>(i), radius2, [&](uint32_t j) {
+					if (!isExcluded(static_cast<uint32_t>(i), j))
+						neighborCount++;
+				});
+				offsets[i + 1] = neighborCount;
+			}
+			#pragma omp single
+			{
+				for (int i = 0; i < count; i++)
+					offsets[i + 1] += offsets[i];
+				neighbors.resize(offsets[count]);
+			}
+
+			#pragma omp for schedule(dynamic, 256)
+			for (int i = 0; i < count; i++) {
+				uint32_t cursor = offsets[i];
+				grid.forEachNeighbor(positions, static_cast<uint32_t>(i), radius2, [&](uint32_t j) {
+					if (!isExcluded(static_cast<uint32_t>(i), j))
+						neighbors[cursor++] = j;
+				});
+				referencePositions[i] = positions[i];
+			}
+		}
+
+		void clear()
+		{
+			offsets.clear();
+			neighbors.clear();
+			referencePositions.clear();
+			radius = -1.0f;
+		}
+	};
+}
+
+#endif
@@ -2,20 +2,91 @@
 #define TISSUSOA_H
 
 #include <iostream>
-#include <glad/glad.h>
+#include <stdexcept>
 #include <glm/glm.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <vector>
 #include <memory>
+#include <utility>
 #include <glm/gtc/epsilon.hpp>
 #include <glm/gtx/norm.hpp>
 #include <omp.h>
-#include <tuple>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include "simd_kernels.h"
+#include "implicit_solver.h"
+#include "projective_solver.h"
+#include "sleep_tiles.h"
+#include "spatial_hash.h"
+#include "triangle_bvh.h"
+#include "continuous_collision.h"
 
 // ----------------------------------------------------------------------------------------------------
 
 namespace Tissu
 {
+	// ------------------------------------------------------------------------------------------------
+	// Vertex Ordering
+	// Rang en memoire du point (x, y) de la grille :
+	//   ROW_MAJOR : x * resolutionY + y (les voisins en x sont a resolutionY cases)
+	//   TILED     : tuiles de orderingTileSize x orderingTileSize points, chaque tuile contigue (ligne par ligne dedans)
+	//   MORTON    : courbe en Z (bits de x et y entrelaces), compactee aux cases de la grille
+	enum class VertexOrdering {
+		ROW_MAJOR,
+		TILED,
+		MORTON,
+	};
+	constexpr int orderingTileSize = 8;
+
+	inline const char* toString(VertexOrdering ordering)
+	{
+		switch (ordering)
+		{
+		case VertexOrdering::ROW_MAJOR: return "rowMajor";
+		case VertexOrdering::TILED:     return "tiled";
+		case VertexOrdering::MORTON:    return "morton";
+		}
+		return "unknown";
+	}
+
+	inline VertexOrdering parseVertexOrdering(const std::string& name)
+	{
+		if (name == "tiled")  return VertexOrdering::TILED;
+		if (name == "morton") return VertexOrdering::MORTON;
+		if (name != "rowMajor")
+			std::cerr << "ERROR: Tissu: Unknown vertex ordering \"" << name << "\", using rowMajor" << std::endl;
+		return VertexOrdering::ROW_MAJOR;
+	}
+
+	// ------------------------------------------------------------------------------------------------
+	// Verlet State
+	// Triple buffer de Verlet dans un type scalaire donne (meme rotation que TissuSoA::updateVertexPosition)
+	// VerletState<double> porte les positions des modes de precision double et mixte (physicSoA.h) ;
+	// les buffers float de TissuSoA en restent une copie arrondie, lue par le rendu, l'export et les autres chemins.
+	template <typename Scalar>
+	struct VerletState {
+		using Vec3 = glm::vec<3, Scalar>;
+
+		std::vector<Vec3> positionsNew;
+		std::vector<Vec3> positions;
+		std::vector<Vec3> positionsOld;
+
+		inline size_t size() const { return positions.size(); }
+		inline Vec3 vitesse(size_t i) const { return positions[i] - positionsOld[i]; }
+		void updateVertexPosition()
+		{
+			std::swap(positionsOld, positions);
+			std::swap(positions, positionsNew);
+		}
+		void clear()
+		{
+			positionsNew.clear();
+			positions.clear();
+			positionsOld.clear();
+		}
+	};
+
 	// ------------------------------------------------------------------------------------------------
 	// Settings Struct
 	struct TissuSettings
@@ -25,11 +96,14 @@ namespace Tissu
 		float sizeY = 10.8f;
 		unsigned int resolutionX = 5;
 		unsigned int resolutionY = 5;
-		GLfloat startingHeight = 0.5f;
+		float startingHeight = 0.5f;
 		float gapPointStartX = 0.1f;
 		float gapPointStartY = 0.1f;
 		float floorHeight = -10.0f;
 		float mass = 1.0f;
+		// Masse par point, dans l'ordre de la grille (x * resolutionY + y). Vide : mass pour tous les points
+		std::vector<float> massMap;
+		VertexOrdering ordering = VertexOrdering::ROW_MAJOR;
 		TissuSettings()
 		{
 			gapPointStartX = sizeX / resolutionX;
@@ -37,6 +111,19 @@ namespace Tissu
 		}
 	};
 
+	// ----------------------------------------------------------------------------------------------------
+	// Vertex Flags
+	// Un octet par point (TissuSoA::vertexFlags) : lecture directe sans le proxy de std::vector<bool>,
+	// et chaque point a son propre octet, un thread peut donc ecrire le sien pendant une boucle parallele.
+	enum VertexFlag : uint8_t {
+		VERTEX_PHYSICS = 1 << 0, //Not used
+		VERTEX_GRAVITY = 1 << 1,
+		VERTEX_TENSION = 1 << 2, //Not used
+		VERTEX_FIXED   = 1 << 3,
+		VERTEX_GRABBED = 1 << 4, //Not used
+	};
+	constexpr uint8_t defaultVertexFlags = VERTEX_PHYSICS | VERTEX_GRAVITY | VERTEX_TENSION;
+
 	// ----------------------------------------------------------------------------------------------------
 	// Vertex Attributes
 	class TissuSoA
@@ -46,26 +133,62 @@ namespace Tissu
 		// Attributes
 		TissuSettings tissuSettings;
 
+		// Triple buffer tournant (voir updateVertexPosition) : on echange les vecteurs, on ne copie pas les points
+		// La vitesse n'est pas stockee : vitesse(i) = positions[i] - positionsOld[i] (deplacement sur un substep)
 		std::vector<glm::vec3> positionsNew;
 		std::vector<glm::vec3> positions;
 		std::vector<glm::vec3> positionsOld;
-		std::vector<glm::vec3> vitesses;
 		std::vector<glm::vec3> accelerations;
 		std::vector<glm::vec3> normals;
 		std::vector<glm::vec2> uvs;
 		std::vector<glm::vec3> colors; //Not integrated
-		std::vector<glm::vec3> masses; //Not integrated
-
-		std::vector<std::vector<std::tuple<size_t, float>>> linkedVertices;   // size_t est l'indice du voision, le float sa distance-gap pour le ressort
 
-		std::vector<bool> isPhysics; //Not used
-		std::vector<bool> isAffectedGravity;
-		std::vector<bool> isAffectedTension; //Not used
-		std::vector<bool> isFixed;
-		std::vector<bool> isGrabbed;
+		// Masse par point et son inverse. invMasses vaut 0 sur un point fixe : les noyaux multiplient par invMasses
+		// au lieu de tester VERTEX_FIXED (voir setFixed). accelerations accumule des forces, l'acceleration est F * invMasses[i]
+		// Un point fixe a aussi positionsOld == positions : son deplacement (vitesse) est nul, sans masque
+		std::vector<float> masses;
+		std::vector<float> invMasses;
+
+		// Topologie des ressorts en CSR (Compressed Sparse Row), tout est contigu en memoire :
+		// les voisins du point i sont springNeighbors[springOffsets[i]] ... springNeighbors[springOffsets[i + 1] - 1]
+		// et springRestLengths[k] est la longueur a vide du ressort vers springNeighbors[k]
+		std::vector<uint32_t> springOffsets;      // count + 1 entrees
+		std::vector<uint32_t> springNeighbors;
+		std::vector<float> springRestLengths;
+
+		// Liste des ressorts (aretes), chaque ressort n'y apparait qu'une fois : springEdgeA[e] <-> springEdgeB[e]
+		// Les aretes sont rangees par couleur : deux aretes de la meme couleur ne partagent aucun point,
+		// on peut donc les traiter en parallele sans conflit d'ecriture. Couleur c = [springColorOffsets[c], springColorOffsets[c + 1])
+		// Grille structurelle -> 4 couleurs : X pair, X impair, Y pair, Y impair
+		static constexpr int springColorCount = 4;
+		std::vector<uint32_t> springEdgeA;
+		std::vector<uint32_t> springEdgeB;
+		std::vector<float> springEdgeRestLengths;
+		std::vector<uint32_t> springColorOffsets;
+
+		std::vector<uint8_t> vertexFlags; // Combinaison de VertexFlag
+
+		// Numerotation des points (tissuSettings.ordering), vides en ROW_MAJOR (calcul direct) :
+		// gridToIndex[x * resolutionY + y] = indice du point (x, y), indexToGrid[i] = x * resolutionY + y
+		std::vector<uint32_t> gridToIndex;
+		std::vector<uint32_t> indexToGrid;
+
+		// Substeps choisis par le mode adaptatif pour la frame precedente (0 : mode adaptatif inactif, vitesse() suit temporal.substeps)
+		int adaptiveSubsteps = 0;
+		int adaptiveDecreaseDelay = 0;
+
+		// Instanciation du substep choisie pour la frame (Physics::selectSubstepPipeline), -1 hors des chemins classique et fusionne
+		int substepPipelineIndex = -1;
+		// Noyaux choisis pour la frame par le chemin SIMD (Simd::selectKernels), nullptr hors de ce chemin
+		const Simd::KernelTable* simdKernels = nullptr;
+		// Derniers choix ecrits dans la console (Physics::reportFrameChoices)
+		int reportedSubstepPipelineIndex = -1;
+		int reportedAdaptiveSubsteps = 0;
+		const Simd::KernelTable* reportedSimdKernels = nullptr;
 
 		int grabbedIndex = -1;
 		float grabDepth = 10.0f;
+		glm::vec3 grabTarget = glm::vec3(0.0f); // Point vise par la souris, mis a jour par Grabbing chaque frame
 		bool isCornerLocked = true;
 		bool isSideLocked = true;
 
@@ -73,6 +196,34 @@ namespace Tissu
 
 		std::vector<float> VBOBuffer;
 		std::vector<unsigned int> EBOBuffer;
+		// Triangles touchant chaque point en CSR (vent par triangle), le triangle t est EBOBuffer[3t], EBOBuffer[3t + 1], EBOBuffer[3t + 2] :
+		// les triangles du point i sont vertexTriangles[triangleOffsets[i]] ... vertexTriangles[triangleOffsets[i + 1] - 1]
+		std::vector<uint32_t> triangleOffsets;    // count + 1 entrees
+		std::vector<uint32_t> vertexTriangles;
+		std::vector<glm::vec3> triangleForces;    // Force aerodynamique de chaque triangle (tampon du calcul du vent)
+
+		// Layout SoA "vrai" (un tableau de float aligne par composante) pour les noyaux SIMD
+		// Optionnel : rempli seulement quand le chemin SIMD est actif, synchronise une fois par frame
+		Simd::SplitLayout splitLayout;
+		// Systeme lineaire de l'integrateur implicite (alloue au premier pas implicite)
+		ImplicitSolver::BlockSystem implicitSystem;
+		// Multiplicateurs de Lagrange des contraintes de distance XPBD (un par arete, remis a zero a chaque pas)
+		std::vector<float> constraintLambdas;
+		// Matrice globale factorisee de Projective Dynamics (construite au premier pas, gardee tant qu'elle reste valide)
+		ProjectiveSolver::Factorization projectiveFactorization;
+		// Tuiles endormies du chemin Verlet (construites au premier substep avec sleep actif)
+		SleepTiles::TileGrid sleepTiles;
+		// Grille hachee et listes de voisins de l'auto-collision (reconstruites quand un point a trop bouge, voir updateSelfCollisionNeighbors)
+		SpatialHash::HashGrid selfCollisionGrid;
+		SpatialHash::NeighborList selfCollisionNeighbors;
+		// Correction moyenne de chaque point, calculee avant d'etre appliquee (resolution de type Jacobi)
+		std::vector<glm::vec3> selfCollisionCorrections;
+		// Auto-collision par triangles : BVH (construit une fois, recalcule a chaque appel), contacts du pas et nombre de contacts par point
+		TriangleBvh::MeshBvh selfCollisionBvh;
+		std::vector<ContinuousCollision::Contact> selfCollisionContacts;
+		std::vector<int> selfCollisionContactCounts;
+		// Positions en double des modes de precision double et mixte (vide en float), voir pullPreciseState / pushPreciseState
+		VerletState<double> preciseState;
 		// ------------------------------------------------------------------------------------------------
 		// Parsing function
 		inline size_t getIndex(int x, int y) const {
@@ -81,16 +232,46 @@ namespace Tissu
 				y >= tissuSettings.resolutionY) {
 				throw std::out_of_range("getIndex: indices (x, y) OOB.");
 			}
-			return static_cast<size_t>(x * tissuSettings.resolutionY + y);
+			return gridIndex(x, y);
+		}
+		// Sans verification des bornes (boucles physiques)
+		inline size_t gridIndex(int x, int y) const {
+			const size_t cell = static_cast<size_t>(x) * tissuSettings.resolutionY + y;
+			return gridToIndex.empty() ? cell : gridToIndex[cell];
+		}
+		inline int gridX(size_t i) const {
+			return static_cast<int>((indexToGrid.empty() ? i : indexToGrid[i]) / tissuSettings.resolutionY);
+		}
+		inline int gridY(size_t i) const {
+			return static_cast<int>((indexToGrid.empty() ? i : indexToGrid[i]) % tissuSettings.resolutionY);
 		}
 		
+		// ------------------------------------------------------------------------------------------------
+		// Flags
+		inline bool isFixed(size_t i) const { return (vertexFlags[i] & VERTEX_FIXED) != 0; }
+		inline bool isAffectedGravity(size_t i) const { return (vertexFlags[i] & VERTEX_GRAVITY) != 0; }
+		inline void setFixed(size_t i, bool boolean) {
+			vertexFlags[i] = boolean ? (vertexFlags[i] | VERTEX_FIXED) : (vertexFlags[i] & ~VERTEX_FIXED);
+			invMasses[i] = boolean ? 0.0f : 1.0f / masses[i];
+			positionsOld[i] = boolean ? positions[i] : positionsOld[i]; // Vitesse nulle
+		}
+		// Pose sur le sol pendant un pas (sans branche) : drapeau et invMass seulement, positionsOld est encore lu par les voisins.
+		// Le pas laisse le point en place, la rotation des buffers donne positionsOld == positions
+		inline void markLanded(size_t i, bool lands) {
+			vertexFlags[i] |= lands ? VERTEX_FIXED : 0;
+			invMasses[i] = lands ? 0.0f : invMasses[i];
+		}
+
 		// ------------------------------------------------------------------------------------------------
 		// Constructor
 		TissuSoA(TissuSettings tissuSettings) : tissuSettings(tissuSettings)
 		{
+			calculationVertexOrdering();
 			Initialisation();
 			calculationVertexNeighbors();
+			calculationSpringEdges();
 			generateEBOBuffer();
+			calculationVertexTriangles();
 			calculationNormals();
 			calculationUVs();
 			generateVBOBuffer();
@@ -98,6 +279,51 @@ namespace Tissu
 
 		// ------------------------------------------------------------------------------------------------
 		// Generation Methods
+		void calculationVertexOrdering()
+		{
+			const size_t resX = this->tissuSettings.resolutionX;
+			const size_t resY = this->tissuSettings.resolutionY;
+			gridToIndex.clear();
+			indexToGrid.clear();
+			if (this->tissuSettings.ordering == VertexOrdering::ROW_MAJOR)
+				return;
+
+			// Cle de tri de chaque case, puis rang de la case dans l'ordre des cles (compacte meme si la grille
+			// n'est pas un multiple de la tuile ou une puissance de 2)
+			const size_t tileCountY = (resY + orderingTileSize - 1) / orderingTileSize;
+			auto mortonSpread = [](uint64_t v) { // Bits de v sur les positions paires
+				v &= 0xFFFFFFFFull;
+				v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+				v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+				v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+				v = (v | (v << 2)) & 0x3333333333333333ull;
+				v = (v | (v << 1)) & 0x5555555555555555ull;
+				return v;
+			};
+			std::vector<std::pair<uint64_t, uint32_t>> keys;
+			keys.reserve(resX * resY);
+			for (size_t x = 0; x < resX; x++) {
+				for (size_t y = 0; y < resY; y++) {
+					uint64_t key;
+					if (this->tissuSettings.ordering == VertexOrdering::TILED) {
+						const uint64_t tile = (x / orderingTileSize) * tileCountY + (y / orderingTileSize);
+						key = tile * orderingTileSize * orderingTileSize + (x % orderingTileSize) * orderingTileSize + (y % orderingTileSize);
+					}
+					else {
+						key = (mortonSpread(x) << 1) | mortonSpread(y);
+					}
+					keys.emplace_back(key, static_cast<uint32_t>(x * resY + y));
+				}
+			}
+			std::sort(keys.begin(), keys.end());
+
+			gridToIndex.resize(keys.size());
+			indexToGrid.resize(keys.size());
+			for (size_t i = 0; i < keys.size(); i++) {
+				gridToIndex[keys[i].second] = static_cast<uint32_t>(i);
+				indexToGrid[i] = keys[i].second;
+			}
+		}
 		void Initialisation()
 		{
 			int count = tissuSettings.resolutionX * tissuSettings.resolutionY;
@@ -105,20 +331,28 @@ namespace Tissu
 			positionsNew.resize(count);
 			positions.resize(count);
 			positionsOld.resize(count);
-			vitesses.resize(count, glm::vec3(0.0f));
 			accelerations.resize(count, glm::vec3(0.0f));
 			normals.resize(count, glm::vec3(0.0f));
 			uvs.resize(count);
 			colors.resize(count);
-			masses.resize(count);
 
-			linkedVertices.resize(count);
+			vertexFlags.resize(count, defaultVertexFlags);
 
-			isPhysics.resize(count, true);
-			isAffectedGravity.resize(count, true);
-			isAffectedTension.resize(count, true);
-			isFixed.resize(count, false);
-			isGrabbed.resize(count, false);
+			masses.assign(count, this->tissuSettings.mass);
+			const std::vector<float>& massMap = this->tissuSettings.massMap;
+			if (!massMap.empty()) {
+				const bool isPositive = std::all_of(massMap.begin(), massMap.end(), [](float mass) { return mass > 0.0f; });
+				if (massMap.size() != static_cast<size_t>(count) || !isPositive) {
+					std::cerr << "ERROR: Tissu: massMap needs " << count << " positive values (got " << massMap.size() << "), using mass" << std::endl;
+				}
+				else {
+					for (size_t cell = 0; cell < massMap.size(); cell++)
+						masses[gridToIndex.empty() ? cell : gridToIndex[cell]] = massMap[cell];
+				}
+			}
+			invMasses.resize(count);
+			for (int i = 0; i < count; i++)
+				invMasses[i] = isFixed(i) ? 0.0f : 1.0f / masses[i];
 
 			// ---
 
@@ -126,42 +360,108 @@ namespace Tissu
 				for (size_t j = 0; j < this->tissuSettings.resolutionY; j++) {
 					size_t index = getIndex(i, j);
 
-					positions[index] = glm::vec3(
+					positions[index] = this->tissuSettings.positionOrigin + glm::vec3(
 						i * this->tissuSettings.gapPointStartX,
 						j * this->tissuSettings.gapPointStartY,
 						this->tissuSettings.startingHeight);
 				}
 			}
+			positionsOld = positions; // Vitesse initiale nulle
+			positionsNew = positions;
 		}
 		void calculationVertexNeighbors() // On stock les indices des points et pas des weak_ptr des points
 		{
+			size_t count = positions.size();
+
+			// 1ere passe : nombre de voisins par point -> offsets
+			springOffsets.assign(count + 1, 0);
+			for (size_t i = 0; i < this->tissuSettings.resolutionX; i++)
+			{
+				for (size_t j = 0; j < this->tissuSettings.resolutionY; j++)
+				{
+					uint32_t nbNeighbors = 0;
+					if (i > 0) nbNeighbors++;
+					if (i < this->tissuSettings.resolutionX - 1) nbNeighbors++;
+					if (j > 0) nbNeighbors++;
+					if (j < this->tissuSettings.resolutionY - 1) nbNeighbors++;
+					springOffsets[getIndex(i, j) + 1] = nbNeighbors;
+				}
+			}
+			for (size_t i = 0; i < count; i++)
+				springOffsets[i + 1] += springOffsets[i];
+
+			// 2eme passe : remplissage des voisins et longueurs a vide
+			springNeighbors.resize(springOffsets[count]);
+			springRestLengths.resize(springOffsets[count]);
 			for (size_t i = 0; i < this->tissuSettings.resolutionX; i++)
 			{
 				for (size_t j = 0; j < this->tissuSettings.resolutionY; j++)
 				{
 					size_t index = getIndex(i, j);
+					uint32_t k = springOffsets[index];
+					auto addSpring = [&](size_t neighbor, float restLength) {
+						springNeighbors[k] = static_cast<uint32_t>(neighbor);
+						springRestLengths[k] = restLength;
+						k++;
+					};
 					if (i > 0)                                       // Gauche
-						this->linkedVertices[index].emplace_back(std::tuple<size_t, float>{ getIndex(i - 1, j), tissuSettings.gapPointStartX });
+						addSpring(getIndex(i - 1, j), tissuSettings.gapPointStartX);
 					if (i < this->tissuSettings.resolutionX - 1)    // Droite
-						this->linkedVertices[index].emplace_back(std::tuple<size_t, float>{ getIndex(i + 1, j), tissuSettings.gapPointStartX });
+						addSpring(getIndex(i + 1, j), tissuSettings.gapPointStartX);
 					if (j > 0)                                      // Bas
-						this->linkedVertices[index].emplace_back(std::tuple<size_t, float>{ getIndex(i, j - 1), tissuSettings.gapPointStartY });
+						addSpring(getIndex(i, j - 1), tissuSettings.gapPointStartY);
 					if (j < this->tissuSettings.resolutionY - 1)    // Haut
-						this->linkedVertices[index].emplace_back(std::tuple<size_t, float>{ getIndex(i, j + 1), tissuSettings.gapPointStartY });
+						addSpring(getIndex(i, j + 1), tissuSettings.gapPointStartY);
 				}
 			}
 		}
+		void calculationSpringEdges()
+		{
+			const size_t resX = this->tissuSettings.resolutionX;
+			const size_t resY = this->tissuSettings.resolutionY;
+			size_t edgeCount = (resX - 1) * resY + resX * (resY - 1);
+
+			springEdgeA.clear();
+			springEdgeB.clear();
+			springEdgeRestLengths.clear();
+			springEdgeA.reserve(edgeCount);
+			springEdgeB.reserve(edgeCount);
+			springEdgeRestLengths.reserve(edgeCount);
+			springColorOffsets.assign(springColorCount + 1, 0);
+
+			auto addEdge = [&](size_t a, size_t b, float restLength) {
+				springEdgeA.emplace_back(static_cast<uint32_t>(a));
+				springEdgeB.emplace_back(static_cast<uint32_t>(b));
+				springEdgeRestLengths.emplace_back(restLength);
+			};
+
+			// Couleurs 0 et 1 : ressorts (i, j) - (i + 1, j), i pair puis i impair
+			for (size_t parity = 0; parity < 2; parity++) {
+				for (size_t i = parity; i + 1 < resX; i += 2)
+					for (size_t j = 0; j < resY; j++)
+						addEdge(getIndex(i, j), getIndex(i + 1, j), tissuSettings.gapPointStartX);
+				springColorOffsets[parity + 1] = static_cast<uint32_t>(springEdgeA.size());
+			}
+			// Couleurs 2 et 3 : ressorts (i, j) - (i, j + 1), j pair puis j impair
+			for (size_t parity = 0; parity < 2; parity++) {
+				for (size_t i = 0; i < resX; i++)
+					for (size_t j = parity; j + 1 < resY; j += 2)
+						addEdge(getIndex(i, j), getIndex(i, j + 1), tissuSettings.gapPointStartY);
+				springColorOffsets[parity + 3] = static_cast<uint32_t>(springEdgeA.size());
+			}
+		}
 		void generateEBOBuffer()
 		{
 			EBOBuffer.clear();
 			EBOBuffer.reserve((tissuSettings.resolutionX - 1) * (tissuSettings.resolutionY - 1) * 6);
 
-			for (size_t i = 0; i < tissuSettings.resolutionX - 1; ++i) {
-				for (size_t j = 0; j < tissuSettings.resolutionY - 1; ++j) {
-					size_t i0 = i + j * tissuSettings.resolutionX;
-					size_t i1 = (i + 1) + j * tissuSettings.resolutionX;
-					size_t i2 = (i + 1) + (j + 1) * tissuSettings.resolutionX;
-					size_t i3 = i + (j + 1) * tissuSettings.resolutionX;
+			// Quad (x, y) - (x + 1, y + 1), parcouru y puis x
+			for (size_t y = 0; y < tissuSettings.resolutionY - 1; ++y) {
+				for (size_t x = 0; x < tissuSettings.resolutionX - 1; ++x) {
+					size_t i0 = getIndex(x, y);
+					size_t i1 = getIndex(x, y + 1);
+					size_t i2 = getIndex(x + 1, y + 1);
+					size_t i3 = getIndex(x + 1, y);
 
 					// Triangle 1
 					EBOBuffer.emplace_back(i0);
@@ -175,6 +475,25 @@ namespace Tissu
 				}
 			}
 		}
+		void calculationVertexTriangles()
+		{
+			const size_t count = positions.size();
+			const size_t triangleCount = EBOBuffer.size() / 3;
+			triangleOffsets.assign(count + 1, 0);
+			for (unsigned int index : EBOBuffer)
+				triangleOffsets[index + 1]++;
+			for (size_t i = 0; i < count; i++)
+				triangleOffsets[i + 1] += triangleOffsets[i];
+
+			// Remplissage dans l'ordre des triangles : la somme par point suit toujours le meme ordre (resultat deterministe)
+			vertexTriangles.resize(EBOBuffer.size());
+			std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+			for (size_t t = 0; t < triangleCount; t++)
+				for (int k = 0; k < 3; k++)
+					vertexTriangles[cursor[EBOBuffer[3 * t + k]]++] = static_cast<uint32_t>(t);
+
+			triangleForces.assign(triangleCount, glm::vec3(0.0f));
+		}
 		void calculationNormals()
 		{
 			// Reset Normals
@@ -229,32 +548,72 @@ namespace Tissu
 			VBOBuffer.clear();
 			VBOBuffer.reserve(this->tissuSettings.resolutionX * this->tissuSettings.resolutionY * 8);
 
-			for (size_t i = 0; i < this->tissuSettings.resolutionX; i++) {
-				for (size_t j = 0; j < this->tissuSettings.resolutionY; j++) {
-					size_t index = getIndex(i, j);
-					//VertexPosVec
-					this->VBOBuffer.emplace_back(this->positions[index].x);
-					this->VBOBuffer.emplace_back(this->positions[index].y);
-					this->VBOBuffer.emplace_back(this->positions[index].z);
-					//NormalVec
-					this->VBOBuffer.emplace_back(this->normals[index].x);
-					this->VBOBuffer.emplace_back(this->normals[index].y);
-					this->VBOBuffer.emplace_back(this->normals[index].z);
-					//TextureVec
-					this->VBOBuffer.emplace_back(this->uvs[index].x);
-					this->VBOBuffer.emplace_back(this->uvs[index].y);
-				}
+			// Dans l'ordre de la memoire : le sommet k du VBO est le point k (indices de l'EBO)
+			for (size_t index = 0; index < this->positions.size(); index++) {
+				//VertexPosVec
+				this->VBOBuffer.emplace_back(this->positions[index].x);
+				this->VBOBuffer.emplace_back(this->positions[index].y);
+				this->VBOBuffer.emplace_back(this->positions[index].z);
+				//NormalVec
+				this->VBOBuffer.emplace_back(this->normals[index].x);
+				this->VBOBuffer.emplace_back(this->normals[index].y);
+				this->VBOBuffer.emplace_back(this->normals[index].z);
+				//TextureVec
+				this->VBOBuffer.emplace_back(this->uvs[index].x);
+				this->VBOBuffer.emplace_back(this->uvs[index].y);
 			}
 		}
 
 		// ------------------------------------------------------------------------------------------------
 		// Utility Methods
-		void updateVertexPosition()  // (0.0f) -> NewPos -> Pos -> OldPos -> *Void*
+		void updateVertexPosition()  // NewPos -> Pos -> OldPos -> NewPos (rotation des buffers, O(1), l'ancien OldPos sera ecrase par Verlet)
 		{
-			for (size_t i = 0; i < this->accelerations.size(); i++) {
-				this->positionsOld[i] = this->positions[i];
-				this->positions[i] = this->positionsNew[i];
-				this->positionsNew[i] = glm::vec3(0.0f);
+			std::swap(this->positionsOld, this->positions);
+			std::swap(this->positions, this->positionsNew);
+		}
+		inline glm::vec3 vitesse(size_t i) const {
+			return this->positions[i] - this->positionsOld[i];
+		}
+		// Change la duree de substep a laquelle se rapporte vitesse() (vitesse physique conservee) : vitesse *= factor
+		void rescaleVitesses(float factor) {
+			const bool isPrecise = preciseState.size() == positions.size();
+			if (isPrecise)
+				pullPreciseState();
+			#pragma omp parallel for
+			for (int i = 0; i < static_cast<int>(this->positions.size()); i++) {
+				if (isPrecise) {
+					preciseState.positionsOld[i] = preciseState.positions[i] - preciseState.vitesse(i) * static_cast<double>(factor);
+					this->positionsOld[i] = glm::vec3(preciseState.positionsOld[i]);
+				}
+				else {
+					this->positionsOld[i] = this->positions[i] - (this->positions[i] - this->positionsOld[i]) * factor;
+				}
+			}
+		}
+		// Debut de frame en precision double / mixte : l'etat double est (re)pris des buffers float pour les points
+		// dont la copie arrondie ne correspond plus (premier appel, resetPosition, auto-collision, autre integrateur entre deux frames)
+		void pullPreciseState() {
+			if (preciseState.size() != positions.size()) {
+				preciseState.positions.assign(positions.begin(), positions.end());
+				preciseState.positionsOld.assign(positionsOld.begin(), positionsOld.end());
+				preciseState.positionsNew.assign(positions.begin(), positions.end());
+				return;
+			}
+			#pragma omp parallel for
+			for (int i = 0; i < static_cast<int>(positions.size()); i++) {
+				if (glm::vec3(preciseState.positions[i]) != positions[i] || glm::vec3(preciseState.positionsOld[i]) != positionsOld[i]) {
+					preciseState.positions[i] = positions[i];
+					preciseState.positionsOld[i] = positionsOld[i];
+				}
+			}
+		}
+		// Fin de frame : copie arrondie de l'etat double dans les buffers float
+		void pushPreciseState() {
+			#pragma omp parallel for
+			for (int i = 0; i < static_cast<int>(positions.size()); i++) {
+				positions[i] = glm::vec3(preciseState.positions[i]);
+				positionsOld[i] = glm::vec3(preciseState.positionsOld[i]);
+				positionsNew[i] = positions[i];
 			}
 		}
 		void resetAcceleration() {
@@ -262,41 +621,66 @@ namespace Tissu
 				this->accelerations[i] = glm::vec3(0.0f);
 			}
 		}
-		void computeVitesses() {
-			for (size_t i = 0; i < this->vitesses.size(); i++) {
-				this->vitesses[i] = this->positions[i] - this->positionsOld[i];
+		void packSplitLayout() {
+			if (splitLayout.count != positions.size() || splitLayout.resolutionY != tissuSettings.resolutionY)
+				splitLayout.resize(tissuSettings.resolutionX, tissuSettings.resolutionY);
+
+			#pragma omp parallel for
+			for (int i = 0; i < static_cast<int>(positions.size()); i++) {
+				splitLayout.positions.x[i] = positions[i].x;
+				splitLayout.positions.y[i] = positions[i].y;
+				splitLayout.positions.z[i] = positions[i].z;
+				glm::vec3 velocity = vitesse(i);
+				splitLayout.velocities.x[i] = velocity.x;
+				splitLayout.velocities.y[i] = velocity.y;
+				splitLayout.velocities.z[i] = velocity.z;
+				splitLayout.normals.x[i] = normals[i].x;
+				splitLayout.normals.y[i] = normals[i].y;
+				splitLayout.normals.z[i] = normals[i].z;
+				splitLayout.invMasses[i] = invMasses[i];
+				splitLayout.gravityMasses[i] = isAffectedGravity(i) ? masses[i] : 0.0f;
+			}
+		}
+		void unpackSplitLayout() {
+			#pragma omp parallel for
+			for (int i = 0; i < static_cast<int>(positions.size()); i++) {
+				positions[i] = glm::vec3(splitLayout.positions.x[i], splitLayout.positions.y[i], splitLayout.positions.z[i]);
+				positionsOld[i] = positions[i] - glm::vec3(splitLayout.velocities.x[i], splitLayout.velocities.y[i], splitLayout.velocities.z[i]);
+				accelerations[i] = glm::vec3(splitLayout.accelerations.x[i], splitLayout.accelerations.y[i], splitLayout.accelerations.z[i]);
+				setFixed(i, splitLayout.invMasses[i] == 0.0f); // Apres positionsOld : un point pose dans le noyau perd sa derniere vitesse
 			}
 		}
 		void lockCorner(bool boolean) {
-			this->isFixed[this->getIndex(0, 0)] = boolean;
-			this->isFixed[this->getIndex(0, this->tissuSettings.resolutionY - 1)] = boolean;
-			this->isFixed[this->getIndex(this->tissuSettings.resolutionX - 1, 0)] = boolean;
-			this->isFixed[this->getIndex(this->tissuSettings.resolutionX - 1, this->tissuSettings.resolutionY - 1)] = boolean;
+			this->setFixed(this->getIndex(0, 0), boolean);
+			this->setFixed(this->getIndex(0, this->tissuSettings.resolutionY - 1), boolean);
+			this->setFixed(this->getIndex(this->tissuSettings.resolutionX - 1, 0), boolean);
+			this->setFixed(this->getIndex(this->tissuSettings.resolutionX - 1, this->tissuSettings.resolutionY - 1), boolean);
 			this->isCornerLocked = boolean;
 			this->isSideLocked = boolean;
+			this->sleepTiles.isWakeRequested = true;
 		}
 		void lockSide(bool boolean) {
-			this->isFixed[this->getIndex(0, this->tissuSettings.resolutionY - 1)] = boolean;
-			this->isFixed[this->getIndex(this->tissuSettings.resolutionX - 1, this->tissuSettings.resolutionY - 1)] = boolean;
+			this->setFixed(this->getIndex(0, this->tissuSettings.resolutionY - 1), boolean);
+			this->setFixed(this->getIndex(this->tissuSettings.resolutionX - 1, this->tissuSettings.resolutionY - 1), boolean);
 			this->isSideLocked = boolean;
+			this->sleepTiles.isWakeRequested = true;
 		}
 		void resetPosition() {
 			for (size_t i = 0; i < this->tissuSettings.resolutionX; i++) {
 				for (size_t j = 0; j < this->tissuSettings.resolutionY; j++) {
 					size_t index = getIndex(i, j);
 
-					positions[index] = glm::vec3(
+					positions[index] = this->tissuSettings.positionOrigin + glm::vec3(
 						i * this->tissuSettings.gapPointStartX,
 						j * this->tissuSettings.gapPointStartY,
 						this->tissuSettings.startingHeight);
 				}
 			}
-			for (size_t i = 0; i < this->vitesses.size(); i++) {
+			for (size_t i = 0; i < this->positions.size(); i++) {
 				this->positionsOld[i] = this->positions[i];
 				this->positionsNew[i] = this->positions[i];
-				this->vitesses[i] = glm::vec3(0.0f);
 				this->accelerations[i] = glm::vec3(0.0f);
-				this->isFixed[i] = false;
+				this->setFixed(i, false);
 			}
 			this->isCornerLocked = true;
 			this->isSideLocked = true;
@@ -0,0 +1,326 @@
+#ifndef TRIANGLE_BVH_H
+#define TRIANGLE_BVH_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <cfloat>
+
+// ----------------------------------------------------------------------------------------------------
+// BVH des triangles du tissu (EBOBuffer) pour l'auto-collision par triangles
+// La topologie ne change pas : l'arbre est construit une fois (decoupe au milieu de l'axe le plus long des centres),
+// puis seulement recalcule (refit) a chaque substep. Les boites englobent le deplacement de chaque triangle pendant
+// le pas (positions de debut et de fin), elargies de la moitie de l'epaisseur : deux triangles dont les boites
+// ne se touchent pas ne peuvent pas entrer en contact pendant le pas.
+// Le refit est parallele : boites des triangles, puis les noeuds niveau par niveau, du plus profond a la racine.
+// Les aretes uniques du maillage sont rangees ici aussi (tests arete-arete).
+// Les candidats sont les paires de triangles dont les boites se touchent (parcours de l'arbre contre lui-meme).
+
+namespace TriangleBvh
+{
+	struct Aabb {
+		glm::vec3 min = glm::vec3(FLT_MAX);
+		glm::vec3 max = glm::vec3(-FLT_MAX);
+
+		inline void expand(const glm::vec3& point) { min = glm::min(min, point); max = glm::max(max, point); }
+		inline void expand(const Aabb& box) { min = glm::min(min, box.min); max = glm::max(max, box.max); }
+		inline bool overlaps(const Aabb& box) const
+		{
+			return min.x <= box.max.x && box.min.x <= max.x
+				&& min.y <= box.max.y && box.min.y <= max.y
+				&& min.z <= box.max.z && box.min.z <= max.z;
+		}
+	};
+
+	struct Node {
+		Aabb box;
+		int left = -1;       // Enfants (noeud interne)
+		int right = -1;
+		int first = 0;       // Triangles triangleOrder[first] ... triangleOrder[first + count - 1] (feuille)
+		int count = 0;       // 0 : noeud interne
+	};
+
+	struct MeshBvh {
+		static constexpr int leafSize = 4;
+		static constexpr size_t selfCollisionJobCount = 256;
+
+		std::vector<Node> nodes;               // nodes[0] : racine
+		std::vector<uint32_t> triangleOrder;
+		std::vector<uint32_t> levelNodes;      // Noeuds ranges par profondeur
+		std::vector<uint32_t> levelOffsets;    // Noeuds de profondeur p : levelNodes[levelOffsets[p]] ... levelNodes[levelOffsets[p + 1] - 1]
+		std::vector<Aabb> triangleBoxes;
+
+		std::vector<uint32_t> triangles;       // Copie de l'EBOBuffer (3 indices par triangle)
+		std::vector<glm::uvec2> edges;         // Aretes uniques (a < b)
+		std::vector<uint32_t> triangleEdges;   // 3 aretes par triangle
+		// Chaque point et chaque arete appartient a un seul de ses triangles (le premier) : bits 0 a 2 points, bits 3 a 5 aretes
+		// du triangle. Une paire de triangles ne teste que les primitives qui leur appartiennent, chaque test est fait une fois
+		std::vector<uint8_t> triangleOwnership;
+		std::vector<glm::ivec2> selfCollisionJobs; // Taches du parcours de l'arbre contre lui-meme
+
+		inline size_t triangleCount() const { return triangles.size() / 3; }
+		inline bool matches(const std::vector<unsigned int>& indices) const
+		{
+			return !nodes.empty() && triangles.size() == indices.size();
+		}
+
+		void build(const std::vector<unsigned int>& indices, const std::vector<glm::vec3>& positions)
+		{
+			triangles.assign(indices.begin(), indices.end());
+			const int count = static_cast<int>(triangleCount());
+			if (count == 0) {
+				clear();
+				return;
+			}
+			buildEdges();
+
+			triangleOrder.resize(count);
+			std::iota(triangleOrder.begin(), triangleOrder.end(), 0u);
+			std::vector<glm::vec3> centers(count);
+			for (int t = 0; t < count; t++)
+				centers[t] = (positions[triangles[3 * t]] + positions[triangles[3 * t + 1]] + positions[triangles[3 * t + 2]]) / 3.0f;
+
+			nodes.clear();
+			nodes.reserve(count > 0 ? 2 * count : 1);
+			std::vector<int> depths;
+			std::vector<int> stack;
+			nodes.push_back(Node{});
+			depths.push_back(0);
+			nodes[0].first = 0;
+			nodes[0].count = count;
+			stack.push_back(0);
+			while (!stack.empty()) {
+				const int index = stack.back();
+				stack.pop_back();
+				const int first = nodes[index].first;
+				const int size = nodes[index].count;
+				if (size <= leafSize)
+					continue;
+
+				Aabb centerBox;
+				for (int k = first; k < first + size; k++)
+					centerBox.expand(centers[triangleOrder[k]]);
+				const glm::vec3 extent = centerBox.max - centerBox.min;
+				const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+				// Decoupe au median : arbre equilibre, profondeur log2(count / leafSize)
+				const int middle = first + size / 2;
+				std::nth_element(triangleOrder.begin() + first, triangleOrder.begin() + middle, triangleOrder.begin() + first + size,
+					[&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis] || (centers[a][axis] == centers[b][axis] && a < b); });
+
+				const int left = static_cast<int>(nodes.size());
+				Node leftNode, rightNode;
+				leftNode.first = first;
+				leftNode.count = middle - first;
+				rightNode.first = middle;
+				rightNode.count = first + size - middle;
+				nodes.push_back(leftNode);
+				nodes.push_back(rightNode);
+				depths.push_back(depths[index] + 1);
+				depths.push_back(depths[index] + 1);
+				nodes[index].left = left;
+				nodes[index].right = left + 1;
+				nodes[index].count = 0;
+				stack.push_back(left);
+				stack.push_back(left + 1);
+			}
+
+			const int depthCount = *std::max_element(depths.begin(), depths.end()) + 1;
+			levelOffsets.assign(depthCount + 1, 0);
+			for (int depth : depths)
+				levelOffsets[depth + 1]++;
+			for (int d = 0; d < depthCount; d++)
+				levelOffsets[d + 1] += levelOffsets[d];
+			levelNodes.resize(nodes.size());
+			std::vector<uint32_t> cursor(levelOffsets.begin(), levelOffsets.end() - 1);
+			for (size_t n = 0; n < nodes.size(); n++)
+				levelNodes[cursor[depths[n]]++] = static_cast<uint32_t>(n);
+
+			triangleBoxes.resize(count);
+			buildSelfCollisionJobs(selfCollisionJobCount);
+		}
+
+		void buildEdges()
+		{
+			const size_t count = triangleCount();
+			std::vector<glm::uvec2> allEdges;
+			allEdges.reserve(3 * count);
+			for (size_t t = 0; t < count; t++)
+				for (int k = 0; k < 3; k++)
+					allEdges.push_back(sortedEdge(triangles[3 * t + k], triangles[3 * t + (k + 1) % 3]));
+
+			auto less = [](const glm::uvec2& a, const glm::uvec2& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); };
+			edges = allEdges;
+			std::sort(edges.begin(), edges.end(), less);
+			edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+			triangleEdges.resize(3 * count);
+			for (size_t k = 0; k < allEdges.size(); k++)
+				triangleEdges[k] = static_cast<uint32_t>(std::lower_bound(edges.begin(), edges.end(), allEdges[k], less) - edges.begin());
+
+			triangleOwnership.assign(count, 0);
+			std::vector<uint8_t> isVertexOwned, isEdgeOwned(edges.size(), 0);
+			for (size_t t = 0; t < count; t++) {
+				for (int k = 0; k < 3; k++) {
+					const uint32_t vertex = triangles[3 * t + k];
+					if (vertex >= isVertexOwned.size())
+						isVertexOwned.resize(vertex + 1, 0);
+					if (!isVertexOwned[vertex]) {
+						isVertexOwned[vertex] = 1;
+						triangleOwnership[t] |= static_cast<uint8_t>(1 << k);
+					}
+					const uint32_t edge = triangleEdges[3 * t + k];
+					if (!isEdgeOwned[edge]) {
+						isEdgeOwned[edge] = 1;
+						triangleOwnership[t] |= static_cast<uint8_t>(1 << (3 + k));
+					}
+				}
+			}
+		}
+
+		static inline glm::uvec2 sortedEdge(uint32_t a, uint32_t b) { return a < b ? glm::uvec2(a, b) : glm::uvec2(b, a); }
+
+		// Refit (boucles "omp for" orphelines : a appeler par tous les threads d'une region parallele, ou hors region)
+		void refit(const std::vector<glm::vec3>& start, const std::vector<glm::vec3>& end, float margin)
+		{
+			const int count = static_cast<int>(triangleCount());
+			#pragma omp for schedule(static)
+			for (int t = 0; t < count; t++) {
+				Aabb box;
+				for (int k = 0; k < 3; k++) {
+					box.expand(start[triangles[3 * t + k]]);
+					box.expand(end[triangles[3 * t + k]]);
+				}
+				box.min -= glm::vec3(margin);
+				box.max += glm::vec3(margin);
+				triangleBoxes[t] = box;
+			}
+
+			const int depthCount = static_cast<int>(levelOffsets.size()) - 1;
+			for (int depth = depthCount - 1; depth >= 0; depth--) {
+				const int levelBegin = static_cast<int>(levelOffsets[depth]);
+				const int levelEnd = static_cast<int>(levelOffsets[depth + 1]);
+				#pragma omp for schedule(static)
+				for (int k = levelBegin; k < levelEnd; k++) {
+					Node& node = nodes[levelNodes[k]];
+					Aabb box;
+					if (node.count > 0) {
+						for (int i = node.first; i < node.first + node.count; i++)
+							box.expand(triangleBoxes[triangleOrder[i]]);
+					}
+					else {
+						box.expand(nodes[node.left].box);
+						box.expand(nodes[node.right].box);
+					}
+					node.box = box;
+				}
+			}
+		}
+
+		// ------------------------------------------------------------------------------------------------
+		// Paires de triangles dont les boites se touchent : parcours de l'arbre contre lui-meme, chaque paire de noeuds une fois.
+		// Les premiers niveaux sont deplies en une liste de taches (jobs) traitees en parallele : une tache (a, a) cherche
+		// les paires dans le sous-arbre a, une tache (a, b) les paires entre les sous-arbres a et b
+		void expandJob(const glm::ivec2& job, std::vector<glm::ivec2>& expanded) const
+		{
+			const Node& nodeA = nodes[job.x];
+			const Node& nodeB = nodes[job.y];
+			if (job.x == job.y) {
+				if (nodeA.count > 0) { expanded.push_back(job); return; }
+				expanded.push_back(glm::ivec2(nodeA.left, nodeA.left));
+				expanded.push_back(glm::ivec2(nodeA.right, nodeA.right));
+				expanded.push_back(glm::ivec2(nodeA.left, nodeA.right));
+				return;
+			}
+			if (nodeA.count > 0 && nodeB.count > 0) { expanded.push_back(job); return; }
+			if (nodeA.count == 0) {
+				expanded.push_back(glm::ivec2(nodeA.left, job.y));
+				expanded.push_back(glm::ivec2(nodeA.right, job.y));
+			}
+			else {
+				expanded.push_back(glm::ivec2(job.x, nodeB.left));
+				expanded.push_back(glm::ivec2(job.x, nodeB.right));
+			}
+		}
+
+		// Ne depend que de la topologie de l'arbre : construite avec lui
+		void buildSelfCollisionJobs(size_t targetCount)
+		{
+			selfCollisionJobs.assign(1, glm::ivec2(0, 0));
+			while (selfCollisionJobs.size() < targetCount) {
+				std::vector<glm::ivec2> expanded;
+				for (const glm::ivec2& job : selfCollisionJobs)
+					expandJob(job, expanded);
+				if (expanded.size() == selfCollisionJobs.size())
+					break; // Que des feuilles
+				selfCollisionJobs.swap(expanded);
+			}
+		}
+
+		template <typename Visitor>
+		inline void runSelfCollisionJob(const glm::ivec2& job, Visitor&& visit) const
+		{
+			if (job.x == job.y) selfCollide(job.x, visit);
+			else collide(job.x, job.y, visit);
+		}
+
+		template <typename Visitor>
+		void selfCollide(int index, Visitor& visit) const
+		{
+			const Node& node = nodes[index];
+			if (node.count > 0) {
+				for (int i = node.first; i < node.first + node.count; i++)
+					for (int j = i + 1; j < node.first + node.count; j++)
+						if (triangleBoxes[triangleOrder[i]].overlaps(triangleBoxes[triangleOrder[j]]))
+							visit(triangleOrder[i], triangleOrder[j]);
+				return;
+			}
+			selfCollide(node.left, visit);
+			selfCollide(node.right, visit);
+			collide(node.left, node.right, visit);
+		}
+
+		template <typename Visitor>
+		void collide(int indexA, int indexB, Visitor& visit) const
+		{
+			const Node& nodeA = nodes[indexA];
+			const Node& nodeB = nodes[indexB];
+			if (!nodeA.box.overlaps(nodeB.box))
+				return;
+			if (nodeA.count > 0 && nodeB.count > 0) {
+				for (int i = nodeA.first; i < nodeA.first + nodeA.count; i++)
+					for (int j = nodeB.first; j < nodeB.first + nodeB.count; j++)
+						if (triangleBoxes[triangleOrder[i]].overlaps(triangleBoxes[triangleOrder[j]]))
+							visit(triangleOrder[i], triangleOrder[j]);
+				return;
+			}
+			// On descend dans le noeud interne (le premier s'il y en a deux)
+			if (nodeA.count == 0) {
+				collide(nodeA.left, indexB, visit);
+				collide(nodeA.right, indexB, visit);
+			}
+			else {
+				collide(indexA, nodeB.left, visit);
+				collide(indexA, nodeB.right, visit);
+			}
+		}
+
+		void clear()
+		{
+			nodes.clear();
+			triangleOrder.clear();
+			levelNodes.clear();
+			levelOffsets.clear();
+			triangleBoxes.clear();
+			triangles.clear();
+			edges.clear();
+			triangleEdges.clear();
+			triangleOwnership.clear();
+			selfCollisionJobs.clear();
+		}
+	};
+}
+
+#endif